@@ -1,6 +1,8 @@
 #pragma once
 
 #include "alloc/boxed.h"
+#include "alloc/rc.h"
+#include "alloc/stats.h"
 #include "alloc/string.h"
 #include "alloc/vec.h"
 
@@ -8,6 +10,8 @@ namespace sfc {
 
 using boxed::Box;
 
+using rc::Rc;
+
 using string::String;
 
 using vec::Vec;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "../core.h"
+#include "../core/mod.h"
 
 namespace sfc::alloc {
 
@@ -40,42 +40,55 @@ struct Layout {
   }
 };
 
-struct System {
-  static auto alloc(Layout layout) -> void*;
-  static auto alloc_zeroed(Layout layout) -> void*;
-  static void dealloc(void* p, Layout layout);
-  static auto realloc(void* p, Layout layout, usize new_size) -> void*;
-
+// the typed calls, for any `A` with the four raw ones.
+template <class A>
+struct AllocExt {
   template <class T>
   static auto alloc_one() -> T* {
-    const auto ptr = System::alloc(Layout::one<T>());
+    const auto ptr = A::alloc(Layout::one<T>());
     return static_cast<T*>(ptr);
   }
 
   template <class T>
   static void dealloc_one(T* ptr) {
-    System::dealloc(ptr, Layout::one<T>());
+    A::dealloc(ptr, Layout::one<T>());
   }
 
   template <class T>
   static auto alloc_array(usize len) -> T* {
-    const auto p = System::alloc(Layout::array<T>(len));
+    const auto p = A::alloc(Layout::array<T>(len));
     return static_cast<T*>(p);
   }
 
   template <class T>
   static void dealloc_array(T* ptr, usize len) {
-    System::dealloc(ptr, Layout::array<T>(len));
+    A::dealloc(ptr, Layout::array<T>(len));
   }
 
   template <class T>
   static auto realloc_array(T* old_ptr, usize old_len, usize new_len) -> T* {
-    auto ptr = System::realloc(old_ptr, Layout::array<T>(old_len), new_len * sizeof(T));
+    auto ptr = A::realloc(old_ptr, Layout::array<T>(old_len), new_len * sizeof(T));
     return static_cast<T*>(ptr);
   }
 };
 
-using Global = System;
+struct System : AllocExt<System> {
+  static auto alloc(Layout layout) -> void*;
+  static auto alloc_zeroed(Layout layout) -> void*;
+  static void dealloc(void* p, Layout layout);
+  static auto realloc(void* p, Layout layout, usize new_size) -> void*;
+};
+
+// `System`, counted by alloc/stats.h once `stats::enable()` is called; until
+// then each call costs one relaxed load more.
+struct Profiled : AllocExt<Profiled> {
+  static auto alloc(Layout layout) -> void*;
+  static auto alloc_zeroed(Layout layout) -> void*;
+  static void dealloc(void* p, Layout layout);
+  static auto realloc(void* p, Layout layout, usize new_size) -> void*;
+};
+
+using Global = Profiled;
 
 static inline auto GLOBAL = Global{};
 
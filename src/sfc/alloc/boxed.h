@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../core.h"
 #include "alloc.h"
 
 namespace sfc::boxed {
@@ -134,9 +135,9 @@ struct Box<R(T...)> {
     };
 
     auto p = GLOBAL.alloc_one<Fx>();
-    ptr::write(p, Fx{._run = &Imp::operator(),                 // run
-                     ._del = [](Fx* p) { (void)Box<Fx>{p}; },  // del
-                     ._imp = sfc::move(f)});                   // imp
+    ptr::write(p, Fx{._run = &Imp::operator(),                                      // run
+                     ._del = [](Fx* p) { ptr::drop(p), GLOBAL.dealloc_one(p); },  // del
+                     ._imp = sfc::move(f)});                                        // imp
     return Box{ptr::cast<IFn>(p)};
   }
 };
@@ -3,7 +3,12 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#if __has_include(<execinfo.h>)
+#include <execinfo.h>
+#endif
+
 #include "../alloc.h"
+#include "../stats.h"
 
 namespace sfc::alloc {
 
@@ -61,4 +66,39 @@ auto System::realloc(void* old_ptr, Layout old_layout, usize new_size) -> void*
 
 }  // namespace sfc::alloc
 
+namespace sfc::alloc::stats {
+
+#if __has_include(<execinfo.h>)
+auto backtrace(Slice<void*> frames, usize skip) -> usize {
+  static constexpr usize MAX_DEPTH = 64;
+  void* buf[MAX_DEPTH];
+  const auto want = cmp::min(frames.len() + skip + 1, MAX_DEPTH);
+  const auto cnt = usize(::backtrace(buf, int(want)));
+  const auto from = cmp::min(skip + 1, cnt);  // +1: this function
+  ptr::copy(buf + from, frames._ptr, cnt - from);
+  return cnt - from;
+}
+
+auto symbol(const void* pc) -> string::String {
+  auto pcs = const_cast<void*>(pc);
+  const auto names = ::backtrace_symbols(&pcs, 1);
+  if (names == nullptr) {
+    return string::format("{}", pc);
+  }
+  auto res = string::String::from_str(Str::from_cstr(names[0]));
+  ::free(names);
+  return res;
+}
+#else
+auto backtrace(Slice<void*>, usize) -> usize {
+  return 0;
+}
+
+auto symbol(const void* pc) -> string::String {
+  return string::format("{}", pc);
+}
+#endif
+
+}  // namespace sfc::alloc::stats
+
 #endif
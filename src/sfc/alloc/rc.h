@@ -0,0 +1,79 @@
+#pragma once
+
+#include "boxed.h"
+
+namespace sfc::rc {
+
+template <class T>
+struct RcInner {
+  usize _strong;
+  T _data;
+};
+
+// a shared reference for a single thread: like `sync::Arc`, with a plain
+// counter instead of an atomic one.
+template <class T>
+struct Rc {
+  using Inner = RcInner<T>;
+  ptr::Unique<Inner> _0;
+
+  explicit Rc(ptr::Unique<Inner> p) : _0{sfc::move(p)} {}
+
+  explicit Rc(T data) : _0{boxed::Box<Inner>{Inner{1u, sfc::move(data)}}.into_raw()} {}
+
+  Rc(Rc&&) noexcept = default;
+
+  Rc(const Rc& other) : _0{other._0.clone()} {
+    _0->_strong += 1;
+  }
+
+  ~Rc() {
+    if (_0.is_null() || --_0->_strong != 0) {
+      return;
+    }
+    mem::drop(_0->_data);
+    alloc::GLOBAL.dealloc_one(_0._0);
+  }
+
+  auto operator=(Rc&& other) noexcept -> Rc& {
+    if (this != &other) {
+      auto tmp = sfc::move(*this);
+      _0 = sfc::move(other._0);
+    }
+    return *this;
+  }
+
+  auto is_null() const -> bool {
+    return _0.is_null();
+  }
+
+  auto strong_count() const -> usize {
+    return _0->_strong;
+  }
+
+  // the data, for writing: shared data is cloned first.
+  auto make_mut() -> T& {
+    if (_0->_strong != 1) {
+      *this = Rc{T{_0->_data}};
+    }
+    return _0->_data;
+  }
+
+  auto operator*() const -> const T& {
+    return _0->_data;
+  }
+
+  auto operator*() -> T& {
+    return _0->_data;
+  }
+
+  auto operator->() const -> const T* {
+    return &_0->_data;
+  }
+
+  auto operator->() -> T* {
+    return &_0->_data;
+  }
+};
+
+}  // namespace sfc::rc
@@ -0,0 +1,319 @@
+#include "stats.h"
+
+#include "../log.h"
+#include "../sync/atomic.h"
+#include "../sync/futex.h"
+
+namespace sfc::alloc::stats {
+
+using sync::Ordering::Relaxed;
+
+static constexpr usize STACK_DEPTH = 16;
+static constexpr usize STACK_SLOTS = 1024;
+
+struct Slot {
+  u64 _hash;  // 0: free
+  u64 _count;
+  u64 _bytes;
+  usize _depth;
+  void* _frames[STACK_DEPTH];
+};
+
+struct ClassCounters {
+  sync::Atomic<u64> _allocs;
+  sync::Atomic<u64> _frees;
+  sync::Atomic<u64> _bytes;
+};
+
+// zero-initialized and never destroyed, so it is there for allocations made
+// before main and after exit alike.
+struct Global {
+  sync::Atomic<u32> _enabled;
+  sync::Atomic<u32> _every;
+  sync::Atomic<u64> _allocs;
+  sync::Atomic<u64> _frees;
+  sync::Atomic<u64> _reallocs;
+  sync::Atomic<u64> _bytes;
+  sync::Atomic<i64> _live;
+  sync::Atomic<i64> _peak;
+  ClassCounters _classes[CLASS_COUNT];
+
+  // the sampled stacks, an open-addressed table under a spin lock.
+  sync::Atomic<u32> _lock;
+  u64 _dropped;  // samples that found the table full
+  Slot _slots[STACK_SLOTS];
+
+  void lock() {
+    while (_lock.exchange(1, sync::Ordering::Acquire) != 0) {
+      sync::spin_loop();
+    }
+  }
+
+  void unlock() {
+    _lock.store(0, sync::Ordering::Release);
+  }
+};
+
+static constinit auto _global = Global{};
+
+// `_busy` keeps the sampler from sampling itself, and `samples` from taking
+// the lock twice when its own `Vec` allocates.
+static thread_local u32 _countdown = 0;
+static thread_local bool _busy = false;
+
+auto size_class(usize size) -> usize {
+  if (size <= 1) {
+    return 0;
+  }
+  return cmp::min(usize(64 - __builtin_clzll(u64(size - 1))), CLASS_COUNT - 1);
+}
+
+static void grow(i64 n) {
+  const auto live = _global._live.fetch_add(n, Relaxed) + n;
+  for (auto peak = _global._peak.load(Relaxed); live > peak; peak = _global._peak.load(Relaxed)) {
+    if (_global._peak.compare_exchange(peak, live, Relaxed)) {
+      break;
+    }
+  }
+}
+
+static void count_in(usize size) {
+  auto& c = _global._classes[stats::size_class(size)];
+  c._allocs.fetch_add(1, Relaxed);
+  c._bytes.fetch_add(size, Relaxed);
+  _global._bytes.fetch_add(size, Relaxed);
+  grow(i64(size));
+}
+
+static void count_out(usize size) {
+  _global._classes[stats::size_class(size)]._frees.fetch_add(1, Relaxed);
+  grow(-i64(size));
+}
+
+static void insert(Slice<void*> frames, usize size) {
+  auto hash = u64(0xcbf29ce484222325);
+  for (usize i = 0; i < frames.len(); ++i) {
+    hash = (hash ^ u64(frames[i])) * 0x100000001b3;
+  }
+  hash |= 1;
+
+  _global.lock();
+  for (usize i = 0; i < STACK_SLOTS; ++i) {
+    auto& slot = _global._slots[(hash + i) & (STACK_SLOTS - 1)];
+    if (slot._hash == 0) {
+      slot._hash = hash;
+      slot._depth = frames.len();
+      ptr::copy(frames._ptr, slot._frames, frames.len());
+    } else if (slot._hash != hash || slot._depth != frames.len()) {
+      continue;
+    }
+    slot._count += 1;
+    slot._bytes += size;
+    _global.unlock();
+    return;
+  }
+  _global._dropped += 1;
+  _global.unlock();
+}
+
+// kept out of line, so that the two frames it skips are itself and the
+// `Profiled` call.
+[[gnu::noinline]] static void sample(usize size) {
+  const auto every = _global._every.load(Relaxed);
+  if (every == 0 || _busy) {
+    return;
+  }
+  if (_countdown == 0 || _countdown > every) {
+    _countdown = every;
+  }
+  if (--_countdown != 0) {
+    return;
+  }
+
+  _busy = true;
+  void* frames[STACK_DEPTH];
+  const auto depth = stats::backtrace(frames, 2);
+  stats::insert({frames, depth}, size);
+  _busy = false;
+}
+
+void enable(u32 sample_every) {
+  _global._every.store(sample_every, Relaxed);
+  _global._enabled.store(1, Relaxed);
+}
+
+void disable() {
+  _global._enabled.store(0, Relaxed);
+}
+
+auto is_enabled() -> bool {
+  return _global._enabled.load(Relaxed) != 0;
+}
+
+void reset() {
+  _global._allocs.store(0, Relaxed);
+  _global._frees.store(0, Relaxed);
+  _global._reallocs.store(0, Relaxed);
+  _global._bytes.store(0, Relaxed);
+  _global._live.store(0, Relaxed);
+  _global._peak.store(0, Relaxed);
+  for (auto& c : _global._classes) {
+    c._allocs.store(0, Relaxed);
+    c._frees.store(0, Relaxed);
+    c._bytes.store(0, Relaxed);
+  }
+
+  _global.lock();
+  ptr::fill(reinterpret_cast<u8*>(_global._slots), u8(0), sizeof(_global._slots));
+  _global._dropped = 0;
+  _global.unlock();
+}
+
+auto summary() -> Summary {
+  auto res = Summary{
+      ._allocs = _global._allocs.load(Relaxed),
+      ._frees = _global._frees.load(Relaxed),
+      ._reallocs = _global._reallocs.load(Relaxed),
+      ._bytes = _global._bytes.load(Relaxed),
+      ._live = _global._live.load(Relaxed),
+      ._peak = _global._peak.load(Relaxed),
+      ._classes = {},
+  };
+  for (usize i = 0; i < CLASS_COUNT; ++i) {
+    const auto& c = _global._classes[i];
+    res._classes[i] = Class{c._allocs.load(Relaxed), c._frees.load(Relaxed), c._bytes.load(Relaxed)};
+  }
+  return res;
+}
+
+auto Summary::operator-(const Summary& other) const -> Summary {
+  auto res = Summary{
+      ._allocs = _allocs - other._allocs,
+      ._frees = _frees - other._frees,
+      ._reallocs = _reallocs - other._reallocs,
+      ._bytes = _bytes - other._bytes,
+      ._live = _live - other._live,
+      ._peak = _peak,
+      ._classes = {},
+  };
+  for (usize i = 0; i < CLASS_COUNT; ++i) {
+    const auto& a = _classes[i];
+    const auto& b = other._classes[i];
+    res._classes[i] = Class{a._allocs - b._allocs, a._frees - b._frees, a._bytes - b._bytes};
+  }
+  return res;
+}
+
+auto samples() -> Vec<Sample> {
+  const auto busy = _busy;
+  _busy = true;
+
+  auto res = Vec<Sample>{};
+  _global.lock();
+  for (const auto& slot : _global._slots) {
+    if (slot._hash == 0) {
+      continue;
+    }
+    auto frames = Vec<void*>::with_capacity(slot._depth);
+    for (usize i = 0; i < slot._depth; ++i) {
+      frames.push(slot._frames[i]);
+    }
+    res.push(Sample{sfc::move(frames), slot._count, slot._bytes});
+  }
+  _global.unlock();
+  _busy = busy;
+
+  res.as_mut_slice().sort_unstable_by([](const Sample& a, const Sample& b) { return a._bytes > b._bytes; });
+  return res;
+}
+
+void report(usize top) {
+  const auto s = stats::summary();
+  log::info("alloc: {} allocs, {} reallocs, {} frees, {} bytes requested, {} live, {} peak", s._allocs,
+            s._reallocs, s._frees, s._bytes, s._live, s._peak);
+  log::info("alloc: {>12} {>12} {>12} {>14}", "size <=", "allocs", "frees", "bytes");
+  for (usize i = 0; i < CLASS_COUNT; ++i) {
+    const auto& c = s._classes[i];
+    if (c._allocs == 0 && c._frees == 0) {
+      continue;
+    }
+    if (i + 1 == CLASS_COUNT) {
+      log::info("alloc: {>12} {>12} {>12} {>14}", "more", c._allocs, c._frees, c._bytes);
+    } else {
+      log::info("alloc: {>12} {>12} {>12} {>14}", u64(1) << i, c._allocs, c._frees, c._bytes);
+    }
+  }
+
+  const auto every = u64(cmp::max(_global._every.load(Relaxed), 1U));
+  const auto xs = stats::samples();
+  if (_global._dropped != 0) {
+    log::warn("alloc: {} samples dropped, the stack table is full", _global._dropped);
+  }
+  for (usize i = 0; i < xs.len() && i < top; ++i) {
+    const auto& x = xs[i];
+    log::info("alloc: #{} ~{} allocs, ~{} bytes (1 in {} sampled)", i, x._count * every, x._bytes * every, every);
+    for (usize k = 0; k < x._frames.len(); ++k) {
+      log::info("alloc:     {}", stats::symbol(x._frames[k]));
+    }
+  }
+}
+
+}  // namespace sfc::alloc::stats
+
+namespace sfc::alloc {
+
+using stats::_global;
+
+auto Profiled::alloc(Layout layout) -> void* {
+  const auto p = System::alloc(layout);
+  if (p != nullptr && _global._enabled.load(stats::Relaxed)) {
+    _global._allocs.fetch_add(1, stats::Relaxed);
+    stats::count_in(layout.size());
+    stats::sample(layout.size());
+  }
+  return p;
+}
+
+auto Profiled::alloc_zeroed(Layout layout) -> void* {
+  const auto p = System::alloc_zeroed(layout);
+  if (p != nullptr && _global._enabled.load(stats::Relaxed)) {
+    _global._allocs.fetch_add(1, stats::Relaxed);
+    stats::count_in(layout.size());
+    stats::sample(layout.size());
+  }
+  return p;
+}
+
+void Profiled::dealloc(void* p, Layout layout) {
+  if (p != nullptr && _global._enabled.load(stats::Relaxed)) {
+    _global._frees.fetch_add(1, stats::Relaxed);
+    stats::count_out(layout.size());
+  }
+  System::dealloc(p, layout);
+}
+
+auto Profiled::realloc(void* p, Layout layout, usize new_size) -> void* {
+  const auto res = System::realloc(p, layout, new_size);
+  if (!_global._enabled.load(stats::Relaxed)) {
+    return res;
+  }
+
+  if (p == nullptr) {
+    if (res != nullptr) {
+      _global._allocs.fetch_add(1, stats::Relaxed);
+      stats::count_in(new_size);
+      stats::sample(new_size);
+    }
+  } else if (new_size == 0) {
+    _global._frees.fetch_add(1, stats::Relaxed);
+    stats::count_out(layout.size());
+  } else {
+    _global._reallocs.fetch_add(1, stats::Relaxed);
+    stats::count_out(layout.size());
+    stats::count_in(new_size);
+    stats::sample(new_size);
+  }
+  return res;
+}
+
+}  // namespace sfc::alloc
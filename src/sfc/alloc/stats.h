@@ -0,0 +1,70 @@
+#pragma once
+
+#include "string.h"
+#include "vec.h"
+
+namespace sfc::alloc::stats {
+
+// sizes by powers of two: class k holds (2^(k-1), 2^k], the last one the rest.
+inline constexpr usize CLASS_COUNT = 32;
+
+auto size_class(usize size) -> usize;
+
+// blocks that ended up in, or left, one size class; a realloc counts as both.
+struct Class {
+  u64 _allocs;
+  u64 _frees;
+  u64 _bytes;  // requested by `_allocs`
+};
+
+// what `alloc::GLOBAL` did since `enable` or `reset`. blocks from before that
+// are not known, so freeing them may take `_live` below zero.
+struct Summary {
+  u64 _allocs;
+  u64 _frees;
+  u64 _reallocs;
+  u64 _bytes;  // requested, by allocs and reallocs
+  i64 _live;
+  i64 _peak;
+  Class _classes[CLASS_COUNT];
+
+  // the difference between two summaries, `_peak` aside.
+  //   const auto s0 = stats::summary();
+  //   run();
+  //   const auto allocs = (stats::summary() - s0)._allocs;
+  auto operator-(const Summary& other) const -> Summary;
+};
+
+// one call stack seen by the sampler.
+struct Sample {
+  vec::Vec<void*> _frames;  // innermost first, starting at the caller of `GLOBAL`
+  u64 _count;               // sampled allocations from here
+  u64 _bytes;               // bytes they requested
+};
+
+// `sample_every`: also records the call stack of one allocation in that many,
+// per thread; 0 records none.
+void enable(u32 sample_every = 0);
+void disable();
+auto is_enabled() -> bool;
+
+// zeroes the counters and forgets the samples.
+void reset();
+
+auto summary() -> Summary;
+
+// the stacks sampled so far, most bytes first.
+auto samples() -> vec::Vec<Sample>;
+
+// the summary, the size classes in use and the `top` stacks, through `log::info`.
+void report(usize top = 10);
+
+// the return addresses of the calling thread, innermost first; `frames[0]`
+// is in the caller's caller when `skip` is 1.
+auto backtrace(Slice<void*> frames, usize skip = 0) -> usize;
+
+// what the dynamic linker knows about `pc`; addresses inside the executable
+// are best resolved with `addr2line`.
+auto symbol(const void* pc) -> string::String;
+
+}  // namespace sfc::alloc::stats
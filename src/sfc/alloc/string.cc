@@ -107,6 +107,10 @@ auto String::operator==(Str other) const -> bool {
   return **this == other;
 }
 
+auto String::operator==(const String& other) const -> bool {
+  return **this == *other;
+}
+
 auto String::operator<=>(Str other) const {
   return **this <=> other;
 }
@@ -115,4 +119,9 @@ void String::format(fmt::Formatter& f) const {
   f.pad(**this);
 }
 
+// same as `Str`, so a map keyed by `String` can be searched with a `Str`.
+void String::hash(hash::Hasher& h) const {
+  hash::Hash<Str>::hash(**this, h);
+}
+
 }  // namespace sfc::string
\ No newline at end of file
@@ -44,6 +44,7 @@ struct String {
   auto write_str(Str s) -> usize;
 
   auto operator==(Str other) const -> bool;
+  auto operator==(const String& other) const -> bool;
   auto operator<=>(Str other) const;
   auto eq_ignore_case(Str other) const -> bool;
 
@@ -68,6 +69,7 @@ struct String {
   }
 
   void format(fmt::Formatter& f) const;
+  void hash(hash::Hasher& h) const;
 };
 
 template <class... T>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../core.h"
 #include "alloc.h"
 
 namespace sfc::vec {
@@ -202,10 +203,10 @@ struct Vec : RawVec<T> {
   auto swap_remove(usize idx) -> T {
     sfc::assert(idx < _len, "sfc::vec::Vec: index out of range");
 
-    auto hole = _ptr + idx;
-    auto last = ptr::read(_ptr + _len - 1);
+    auto hole = _ptr._0 + idx;
+    auto last = ptr::read(_ptr._0 + _len - 1);
     _len -= 1;
-    if (_len == 0) {
+    if (idx == _len) {
       return last;
     }
     return ptr::replace(hole, sfc::move(last));
@@ -262,6 +263,22 @@ struct Vec : RawVec<T> {
     }
   }
 
+  void extend(usize n, const T& val) {
+    this->reserve(n);
+    for (usize i = 0; i < n; ++i) {
+      ptr::write(_ptr._0 + _len, T{val});
+      _len += 1;
+    }
+  }
+
+  void extend_with(usize n, auto&& f) {
+    this->reserve(n);
+    for (usize i = 0; i < n; ++i) {
+      ptr::write(_ptr._0 + _len, f());
+      _len += 1;
+    }
+  }
+
   void append(Vec& other) {
     this->reserve(other.len());
     ptr::copy(other.as_ptr(), _ptr.ptr() + _len, other.len());
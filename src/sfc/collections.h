@@ -1,10 +1,12 @@
 #pragma once
 
+#include "collections/concurrent_hash_map.h"
 #include "collections/vec_deque.h"
 
 namespace sfc::collections {
 
 using vec::Vec;
 using vec_deque::VecDeque;
+using concurrent_hash_map::ConcurrentHashMap;
 
 } // namespace sfc::collections
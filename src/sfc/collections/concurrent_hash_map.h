@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../alloc.h"
+#include "../sync/epoch.h"
+#include "../sync/mutex.h"
+
+namespace sfc::collections::concurrent_hash_map {
+
+using sync::Atomic;
+using sync::Ordering;
+
+// entries are never changed in place: an update links a new entry and
+// retires the old one, so a reader may keep using whatever it found until
+// it unpins.
+template <class K, class V>
+struct Entry {
+  u64 _hash;
+  K _key;
+  V _val;
+};
+
+// open addressing with linear probing. a removed entry leaves a tombstone,
+// so the probe sequences of the keys after it stay unbroken.
+template <class E>
+struct Table {
+  usize _mask;
+  Atomic<E*>* _slots;
+
+  static auto tomb() -> E* {
+    return reinterpret_cast<E*>(usize(1));
+  }
+
+  static auto xnew(usize cap) -> Table* {
+    const auto slots = alloc::GLOBAL.alloc_array<Atomic<E*>>(cap);
+    for (usize i = 0; i < cap; ++i) {
+      ptr::write(slots + i, Atomic<E*>{nullptr});
+    }
+    const auto res = alloc::GLOBAL.alloc_one<Table>();
+    ptr::write(res, Table{cap - 1, slots});
+    return res;
+  }
+
+  // frees the table only; the entries belong to whichever table is newer.
+  static void destroy(void* p) {
+    const auto t = static_cast<Table*>(p);
+    alloc::GLOBAL.dealloc_array(t->_slots, t->_mask + 1);
+    alloc::GLOBAL.dealloc_one(t);
+  }
+
+  auto capacity() const -> usize {
+    return _mask + 1;
+  }
+
+  auto get(u64 hash, const auto& key) const -> E* {
+    for (auto i = usize(hash) & _mask, n = usize(0); n <= _mask; i = (i + 1) & _mask, ++n) {
+      const auto e = _slots[i].load(Ordering::Acquire);
+      if (e == nullptr) {
+        break;
+      }
+      if (e != Table::tomb() && e->_hash == hash && e->_key == key) {
+        return e;
+      }
+    }
+    return nullptr;
+  }
+
+  // the slot holding `key`, or else the first free one on its probe sequence.
+  auto search(u64 hash, const auto& key) const -> Atomic<E*>* {
+    Atomic<E*>* free = nullptr;
+    for (auto i = usize(hash) & _mask, n = usize(0); n <= _mask; i = (i + 1) & _mask, ++n) {
+      const auto e = _slots[i].load(Ordering::Relaxed);
+      if (e == nullptr) {
+        return free ? free : &_slots[i];
+      }
+      if (e == Table::tomb()) {
+        free = free ? free : &_slots[i];
+      } else if (e->_hash == hash && e->_key == key) {
+        return &_slots[i];
+      }
+    }
+    return free;
+  }
+};
+
+template <class E>
+struct alignas(64) Shard {
+  using Table = concurrent_hash_map::Table<E>;
+
+  sync::Mutex _mutex{};
+  Atomic<Table*> _table{nullptr};
+  Atomic<usize> _len{0};
+  usize _used = 0;  // entries and tombstones
+
+  ~Shard() {
+    const auto t = _table.load(Ordering::Relaxed);
+    if (t == nullptr) {
+      return;
+    }
+    for (usize i = 0; i < t->capacity(); ++i) {
+      const auto e = t->_slots[i].load(Ordering::Relaxed);
+      if (e != nullptr && e != Table::tomb()) {
+        ptr::drop(e);
+        alloc::GLOBAL.dealloc_one(e);
+      }
+    }
+    Table::destroy(t);
+  }
+
+  // called with the lock held, before a slot is taken.
+  auto reserve(const sync::epoch::Guard& guard) -> Table* {
+    static constexpr usize MIN_CAP = 8;
+
+    const auto old = _table.load(Ordering::Relaxed);
+    if (old != nullptr && (_used + 1) * 4 <= old->capacity() * 3) {
+      return old;
+    }
+
+    // rehashing drops the tombstones; grow only if the entries need it.
+    const auto len = _len.load(Ordering::Relaxed);
+    auto cap = old ? old->capacity() : MIN_CAP;
+    while ((len + 1) * 2 > cap) {
+      cap *= 2;
+    }
+
+    const auto res = Table::xnew(cap);
+    for (usize i = 0; old && i < old->capacity(); ++i) {
+      const auto e = old->_slots[i].load(Ordering::Relaxed);
+      if (e != nullptr && e != Table::tomb()) {
+        res->search(e->_hash, e->_key)->store(e, Ordering::Relaxed);
+      }
+    }
+    _table.store(res, Ordering::Release);
+    _used = len;
+    if (old != nullptr) {
+      guard.defer(Table::destroy, old);
+    }
+    return res;
+  }
+
+  // links `e` into `slot`, retiring what was there.
+  void link(const sync::epoch::Guard& guard, Atomic<E*>* slot, E* e) {
+    const auto old = slot->exchange(e, Ordering::AcqRel);
+    if (old == nullptr || old == Table::tomb()) {
+      _used += old == nullptr;
+      _len.fetch_add(1, Ordering::Relaxed);
+      return;
+    }
+    guard.defer_destroy(old);
+  }
+};
+
+// a hash map shared by many threads. keys are spread over `SHARDS` tables,
+// each with its own write lock; readers take no lock at all, they only pin
+// the epoch so that nothing they look at is freed under them.
+// values are returned by copy, since an entry may be replaced at any time.
+template <class K, class V>
+struct ConcurrentHashMap {
+  static constexpr usize SHARDS = 64;
+  using Entry = concurrent_hash_map::Entry<K, V>;
+  using Shard = concurrent_hash_map::Shard<Entry>;
+
+  Shard _shards[SHARDS];
+
+  ConcurrentHashMap() = default;
+  ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+
+  auto len() const -> usize {
+    auto res = usize(0);
+    for (auto& s : _shards) {
+      res += s._len.load(Ordering::Relaxed);
+    }
+    return res;
+  }
+
+  auto is_empty() const -> bool {
+    return this->len() == 0;
+  }
+
+  // `key` may be of any type that hashes and compares like `K`, like a
+  // `Str` for a `String` key.
+  auto get(const auto& key) const -> Option<V> {
+    const auto h = hash::hash(key);
+    const auto guard = sync::epoch::pin();
+    const auto e = this->find(h, key);
+    if (e == nullptr) {
+      return option::NONE;
+    }
+    return {option::SOME, V{e->_val}};
+  }
+
+  auto contains_key(const auto& key) const -> bool {
+    const auto h = hash::hash(key);
+    const auto guard = sync::epoch::pin();
+    return this->find(h, key) != nullptr;
+  }
+
+  // returns true if `key` was not in the map before.
+  auto insert(K key, V val) -> bool {
+    const auto h = hash::hash(key);
+    auto& s = this->shard(h);
+    const auto guard = sync::epoch::pin();
+    const auto lock = s._mutex.lock();
+
+    const auto slot = s.reserve(guard)->search(h, key);
+    const auto old = slot->load(Ordering::Relaxed);
+    s.link(guard, slot, this->make(h, sfc::move(key), sfc::move(val)));
+    return old == nullptr || old == Shard::Table::tomb();
+  }
+
+  // the value for `key`, inserting `f()` first if there is none; `f` runs
+  // at most once, and only if the key is missing.
+  auto get_or_insert_with(K key, auto&& f) -> V {
+    const auto h = hash::hash(key);
+    const auto guard = sync::epoch::pin();
+    if (const auto e = this->find(h, key)) {
+      return V{e->_val};
+    }
+
+    auto& s = this->shard(h);
+    const auto lock = s._mutex.lock();
+    const auto slot = s.reserve(guard)->search(h, key);
+    const auto old = slot->load(Ordering::Relaxed);
+    if (old != nullptr && old != Shard::Table::tomb()) {
+      return V{old->_val};
+    }
+    const auto e = this->make(h, sfc::move(key), f());
+    s.link(guard, slot, e);
+    return V{e->_val};
+  }
+
+  // sets the value for `key` to `f(old)`, with `old` an `Option<const V&>`
+  // that is empty if the key is missing. updates of one key never race:
+  // `f` runs with the shard locked, so it must not touch the map.
+  auto upsert(K key, auto&& f) -> V {
+    const auto h = hash::hash(key);
+    auto& s = this->shard(h);
+    const auto guard = sync::epoch::pin();
+    const auto lock = s._mutex.lock();
+
+    const auto slot = s.reserve(guard)->search(h, key);
+    const auto old = slot->load(Ordering::Relaxed);
+    const auto has_old = old != nullptr && old != Shard::Table::tomb();
+    auto val = has_old ? f(Option<const V&>{old->_val}) : f(Option<const V&>{});
+    const auto e = this->make(h, sfc::move(key), sfc::move(val));
+    s.link(guard, slot, e);
+    return V{e->_val};
+  }
+
+  // returns true if `key` was in the map.
+  auto remove(const auto& key) -> bool {
+    const auto h = hash::hash(key);
+    auto& s = this->shard(h);
+    const auto guard = sync::epoch::pin();
+    const auto lock = s._mutex.lock();
+
+    const auto t = s._table.load(Ordering::Relaxed);
+    const auto slot = t ? t->search(h, key) : nullptr;
+    const auto old = slot ? slot->load(Ordering::Relaxed) : nullptr;
+    if (old == nullptr || old == Shard::Table::tomb()) {
+      return false;
+    }
+    slot->store(Shard::Table::tomb(), Ordering::Release);
+    s._len.fetch_sub(1, Ordering::Relaxed);
+    guard.defer_destroy(old);
+    return true;
+  }
+
+  // the top bits pick the shard, the low ones the slot.
+  auto shard(u64 hash) const -> Shard& {
+    static_assert((SHARDS & (SHARDS - 1)) == 0);
+    return const_cast<Shard&>(_shards[hash >> (64 - __builtin_ctzll(SHARDS))]);
+  }
+
+  auto find(u64 hash, const auto& key) const -> Entry* {
+    const auto t = this->shard(hash)._table.load(Ordering::Acquire);
+    return t ? t->get(hash, key) : nullptr;
+  }
+
+  static auto make(u64 hash, K key, V val) -> Entry* {
+    const auto e = alloc::GLOBAL.alloc_one<Entry>();
+    new (ptr::NotNull{e}) Entry{hash, sfc::move(key), sfc::move(val)};
+    return e;
+  }
+};
+
+}  // namespace sfc::collections::concurrent_hash_map
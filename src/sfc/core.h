@@ -1,7 +1,9 @@
 #pragma once
 
 #include "core/cmp.h"
+#include "core/cpu.h"
 #include "core/fmt.h"
+#include "core/hash.h"
 #include "core/iter.h"
 #include "core/mem.h"
 #include "core/num.h"
@@ -0,0 +1,145 @@
+#include "cpu.h"
+
+#include "panicking.h"
+
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace sfc::cpu {
+
+// the level plus one, 0 before the first `level()`.
+static constinit u32 _level = 0;
+
+#if defined(__x86_64__) || defined(__i386__)
+static auto xgetbv() -> u64 {
+  u32 eax, edx;
+  __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (u64(edx) << 32) | eax;
+}
+
+auto Features::detect() -> Features {
+  auto res = Features{};
+  u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    return res;
+  }
+  const auto set = [&](Feature f, u32 reg, u32 bit) {
+    if ((reg >> bit) & 1) {
+      res.insert(f);
+    }
+  };
+  set(Feature::Sse2, edx, 26);
+  set(Feature::Sse3, ecx, 0);
+  set(Feature::Ssse3, ecx, 9);
+  set(Feature::Sse41, ecx, 19);
+  set(Feature::Sse42, ecx, 20);
+  set(Feature::Popcnt, ecx, 23);
+
+  // xmm and ymm state (bits 1, 2), then opmask and zmm state (bits 5, 6, 7).
+  const auto xcr0 = (ecx >> 27) & 1 ? xgetbv() : 0;
+  const auto os_avx = (xcr0 & 0x06) == 0x06;
+  const auto os_avx512 = (xcr0 & 0xE6) == 0xE6;
+  if (os_avx) {
+    set(Feature::Fma, ecx, 12);
+    set(Feature::Avx, ecx, 28);
+  }
+
+  if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    set(Feature::Bmi1, ebx, 3);
+    set(Feature::Bmi2, ebx, 8);
+    if (os_avx) {
+      set(Feature::Avx2, ebx, 5);
+    }
+    if (os_avx512) {
+      set(Feature::Avx512f, ebx, 16);
+      set(Feature::Avx512dq, ebx, 17);
+      set(Feature::Avx512cd, ebx, 28);
+      set(Feature::Avx512bw, ebx, 30);
+      set(Feature::Avx512vl, ebx, 31);
+    }
+  }
+  if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx)) {
+    set(Feature::Lzcnt, ecx, 5);
+  }
+  return res;
+}
+#else
+auto Features::detect() -> Features {
+  return Features{};
+}
+#endif
+
+void Features::format(fmt::Formatter& f) const {
+  static const Str names[] = {
+      "sse2",  "sse3", "ssse3", "sse4.1",  "sse4.2",   "popcnt",   "lzcnt",    "bmi1",    "bmi2",
+      "fma",   "avx",  "avx2",  "avx512f", "avx512dq", "avx512cd", "avx512bw", "avx512vl",
+  };
+  auto sep = Str{};
+  for (usize i = 0; i < array_len(names); ++i) {
+    if (this->has(Feature(i))) {
+      f.write_str(sep);
+      f.write_str(names[i]);
+      sep = " ";
+    }
+  }
+}
+
+static auto max_level(const Features& x) -> Level {
+  const Feature v3[] = {Feature::Avx2, Feature::Fma,    Feature::Bmi1,  Feature::Bmi2,
+                        Feature::Lzcnt, Feature::Popcnt, Feature::Sse42};
+  const Feature v4[] = {Feature::Avx512f, Feature::Avx512dq, Feature::Avx512cd, Feature::Avx512bw,
+                        Feature::Avx512vl};
+  const auto has_all = [&](Slice<const Feature> fs) {
+    for (usize i = 0; i < fs.len(); ++i) {
+      if (!x.has(fs[i])) {
+        return false;
+      }
+    }
+    return true;
+  };
+  if (!has_all(v3)) {
+    return Level::Base;
+  }
+  return has_all(v4) ? Level::Avx512 : Level::Avx2;
+}
+
+auto features() -> const Features& {
+  static const auto res = Features::detect();
+  return res;
+}
+
+auto has(Feature f) -> bool {
+  return cpu::features().has(f);
+}
+
+// what the cpu has, capped by `SFC_CPU`.
+static auto allowed() -> Level {
+  const auto res = max_level(cpu::features());
+  const auto env = Str::from_cstr(::getenv("SFC_CPU"));
+  if (env == "sse2") {
+    return Level::Base;
+  }
+  if (env == "avx2" && res == Level::Avx512) {
+    return Level::Avx2;
+  }
+  return res;
+}
+
+auto level() -> Level {
+  if (const auto x = __atomic_load_n(&_level, __ATOMIC_RELAXED); x != 0) [[likely]] {
+    return Level(x - 1);
+  }
+  const auto res = cpu::allowed();
+  __atomic_store_n(&_level, u32(res) + 1, __ATOMIC_RELAXED);
+  return res;
+}
+
+void set_level(Level level) {
+  const auto top = cpu::allowed();
+  __atomic_store_n(&_level, u32(level < top ? level : top) + 1, __ATOMIC_RELAXED);
+}
+
+}  // namespace sfc::cpu
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "fmt.h"
+
+namespace sfc::cpu {
+
+enum class Feature : u32 {
+  Sse2,
+  Sse3,
+  Ssse3,
+  Sse41,
+  Sse42,
+  Popcnt,
+  Lzcnt,
+  Bmi1,
+  Bmi2,
+  Fma,
+  Avx,
+  Avx2,
+  Avx512f,
+  Avx512dq,
+  Avx512cd,
+  Avx512bw,
+  Avx512vl,
+};
+
+// what the cpu can do, from cpuid; the avx ones only when the os saves the
+// registers they use. none off x86.
+struct Features {
+  u32 _bits = 0;
+
+  static auto detect() -> Features;
+
+  auto has(Feature f) const -> bool {
+    return (_bits >> u32(f)) & 1;
+  }
+
+  void insert(Feature f) {
+    _bits |= u32(1) << u32(f);
+  }
+
+  // like "sse2 sse3 ... avx2".
+  void format(fmt::Formatter& f) const;
+};
+
+// the clones a kernel is built for, each level taking all below it:
+//   Base:   x86-64 (sse2), and any other arch
+//   Avx2:   avx2, fma, bmi1/2, lzcnt, popcnt and sse4.2: x86-64-v3
+//   Avx512: avx512 f, bw, cd, dq and vl on top: x86-64-v4
+enum class Level : u32 {
+  Base,
+  Avx2,
+  Avx512,
+};
+
+// target attributes of the clones, to go with a switch on `cpu::level()`:
+//   [[sfc_target_avx2]] static void scan_avx2(...) { scan<...>(...); }
+#define sfc_target_avx2 gnu::target("avx2,fma,bmi,bmi2,lzcnt,popcnt,sse4.2")
+#define sfc_target_avx512 \
+  gnu::target("avx512f,avx512dq,avx512cd,avx512bw,avx512vl,avx2,fma,bmi,bmi2,lzcnt,popcnt,sse4.2")
+
+// detected once, at the first call.
+auto features() -> const Features&;
+
+auto has(Feature f) -> bool;
+
+// the level the kernels dispatch on: what the cpu has, capped by `SFC_CPU`
+// in the environment when that is "sse2" or "avx2".
+auto level() -> Level;
+
+// lowers, or restores, the level for every dispatch from now on; never above
+// what the cpu and `SFC_CPU` allow.
+void set_level(Level level);
+
+}  // namespace sfc::cpu
@@ -0,0 +1,22 @@
+#include "hash.h"
+
+namespace sfc::hash {
+
+void Hasher::write(Slice<const u8> buf) {
+  auto p = buf.as_ptr();
+  auto n = buf.len();
+  for (; n >= 8; p += 8, n -= 8) {
+    u64 x;
+    __builtin_memcpy(&x, p, 8);
+    this->write_u64(x);
+  }
+
+  // the length goes with the tail, so "a" and "a\0" differ.
+  auto tail = u64(buf.len()) << 56;
+  for (usize i = 0; i < n; ++i) {
+    tail |= u64(p[i]) << (8 * i);
+  }
+  this->write_u64(tail);
+}
+
+}  // namespace sfc::hash
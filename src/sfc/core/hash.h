@@ -1,12 +1,72 @@
 #pragma once
 
-#include "mod.h"
+#include "num.h"
+#include "str.h"
 
 namespace sfc::hash {
 
-template<class T>
+// the murmur3 finalizer: every input bit flips about half of the output
+// bits, so the high bits are as good as the low ones.
+constexpr auto mix64(u64 x) -> u64 {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// a word at a time, fx-style; cheap for the short keys a map usually has.
+struct Hasher {
+  static constexpr u64 SEED = 0x517cc1b727220a95ULL;
+
+  u64 _state = 0;
+
+  void write_u64(u64 x) {
+    _state = ((_state << 5 | _state >> 59) ^ x) * SEED;
+  }
+
+  void write(Slice<const u8> buf);
+
+  auto finish() const -> u64 {
+    return hash::mix64(_state);
+  }
+};
+
+// types without a specialization provide `void hash(Hasher&) const`.
+template <class T, class = void>
 struct Hash {
-  auto hash(const T& val) -> u32;
+  static void hash(const T& val, Hasher& h) {
+    val.hash(h);
+  }
 };
 
+template <class T>
+struct Hash<T, when_t<num::is_int<T>() || __is_same(T, bool) || __is_same(T, char) || __is_enum(T)>> {
+  static void hash(const T& val, Hasher& h) {
+    h.write_u64(u64(val));
+  }
+};
+
+template <class T>
+struct Hash<T*> {
+  static void hash(T* val, Hasher& h) {
+    h.write_u64(reinterpret_cast<usize>(val));
+  }
+};
+
+template <>
+struct Hash<Str> {
+  static void hash(Str val, Hasher& h) {
+    h.write(val.as_bytes());
+  }
+};
+
+template <class T>
+auto hash(const T& val) -> u64 {
+  auto h = Hasher{};
+  Hash<T>::hash(val, h);
+  return h.finish();
 }
+
+}  // namespace sfc::hash
@@ -7,6 +7,8 @@ namespace sfc::mem {
 template <class T>
 union Hole {
   T _val;
+  [[gnu::always_inline]] Hole() {}
+  [[gnu::always_inline]] Hole(T&& val) : _val{static_cast<T&&>(val)} {}
   [[gnu::always_inline]] ~Hole() {}
 };
 
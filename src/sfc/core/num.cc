@@ -308,19 +308,27 @@ struct IntoStr {
   }
 
   auto write_uflt_by_fix(f64 val, usize precision) -> usize {
-    // write: int
-    const auto int_val = u64(val);
-    const auto int_cnt = this->write_uint_by_dcm(int_val);
     if (precision == 0) {
-      return int_cnt;
+      return this->write_uint_by_dcm(u64(__builtin_round(val)));
     }
 
+    // rounding the fraction may carry into the int part: 0.96 => "1.0"
+    const auto flt_cnt = precision;
+    const auto flt_exp = num::fast_exp10(flt_cnt);
+    auto int_val = u64(val);
+    auto flt_val = u64(__builtin_round((val - f64(int_val)) * flt_exp));
+    if (f64(flt_val) >= flt_exp) {
+      int_val += 1;
+      flt_val = 0;
+    }
+
+    // write: int
+    const auto int_cnt = this->write_uint_by_dcm(int_val);
+
     // write: dot
     const auto dot_cnt = this->write_chr('.');
 
     // write: flt
-    const auto flt_cnt = precision;
-    const auto flt_val = u64(__builtin_round((val - f64(int_val)) * num::fast_exp10(flt_cnt)));
     const auto flt_len = num::uint_count_digits_by_dcm(flt_val);
     this->write_chs('0', flt_cnt - flt_len);
     this->write_unit_by_rev(flt_val, flt_len);
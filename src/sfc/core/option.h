@@ -182,7 +182,7 @@ struct Option<T&> {
   }
 
   auto expect(const auto&... msg) -> T& {
-    sfc::assert(this->is_none(), msg...);
+    sfc::assert(this->is_some(), msg...);
     return *_inn;
   }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "mem.h"
+#include "simd.h"
 
 namespace sfc::ptr {
 
@@ -155,6 +156,13 @@ template <class T>
 
 template <class T>
 [[gnu::always_inline]] auto cmp(const T* lhs, const T* rhs, usize cnt) -> isize {
+  if constexpr (simd::is_simd<T>()) {
+    if (cnt >= simd::MIN_LEN) {
+      const auto i = simd::mismatch(simd::canon(lhs), simd::canon(rhs), cnt);
+      if (i == cnt) return 0;
+      return lhs[i] < rhs[i] ? isize(i - cnt) : isize(cnt - i);
+    }
+  }
   for (auto end = lhs + cnt; lhs != end; ++lhs, ++rhs) {
     if (*lhs != *rhs) {
       return *lhs < *rhs ? isize(lhs - end) : isize(end - lhs);
@@ -165,6 +173,11 @@ template <class T>
 
 template <class T>
 [[gnu::always_inline]] auto eq(const T* lhs, const T* rhs, usize cnt) -> bool {
+  if constexpr (simd::is_simd<T>()) {
+    if (cnt >= simd::MIN_LEN) {
+      return simd::mismatch(simd::canon(lhs), simd::canon(rhs), cnt) == cnt;
+    }
+  }
   for (auto end = lhs + cnt; lhs != end; ++lhs, ++rhs) {
     if (*lhs != *rhs) {
       return false;
@@ -175,6 +188,11 @@ template <class T>
 
 template <class T>
 [[gnu::always_inline]] auto ne(const T* lhs, const T* rhs, usize cnt) -> bool {
+  if constexpr (simd::is_simd<T>()) {
+    if (cnt >= simd::MIN_LEN) {
+      return simd::mismatch(simd::canon(lhs), simd::canon(rhs), cnt) != cnt;
+    }
+  }
   for (auto end = lhs + cnt; lhs != end; ++lhs, ++rhs) {
     if (*lhs != *rhs) {
       return true;
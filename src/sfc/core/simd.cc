@@ -0,0 +1,398 @@
+#include "simd.h"
+
+#include "cmp.h"
+#include "cpu.h"
+
+namespace sfc::ptr::simd {
+
+// everything below is inlined into each target clone, with vectors of `W`
+// bytes: one register of the clone's isa.
+template <class T, usize W>
+struct Kernel {
+  using U = typename IntOf<sizeof(T), false>::Type;
+  typedef T V __attribute__((vector_size(W)));
+  typedef U UV __attribute__((vector_size(W)));
+  using M = decltype(V{} < V{});
+
+  static constexpr usize L = W / sizeof(T);
+
+  // how many times a lane of a `UV` counter may grow by one.
+  static constexpr usize MAX_COUNT = sizeof(T) == 1 ? 0xFF : sizeof(T) == 2 ? 0xFFFF : usize(-1);
+
+  // floats are added as 64-byte vectors whatever the isa, each held in `R`
+  // registers, so that every clone adds in the same order.
+  static constexpr usize R = 64 / W;
+  static constexpr usize L64 = R * L;
+
+  // partial sums of floats per block of this many items.
+  static constexpr usize BLOCK = 32 * L64;
+
+  [[gnu::always_inline]] static auto load(const T* p) -> V {
+    V v;
+    __builtin_memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  // a comparison as unsigned lanes, all ones where it holds.
+  [[gnu::always_inline]] static auto lanes(M m) -> UV {
+    return __builtin_bit_cast(UV, m);
+  }
+
+  // halves folded together down to 16 bytes, which every isa tests at once.
+  [[gnu::always_inline]] static auto any(UV m) -> bool {
+    typedef u64 W2 __attribute__((vector_size(16)));
+    typedef u64 W4 __attribute__((vector_size(32)));
+    typedef u64 W8 __attribute__((vector_size(64)));
+    auto w2 = W2{};
+    if constexpr (W == 64) {
+      const auto w8 = __builtin_bit_cast(W8, m);
+      const W4 w4 = __builtin_shufflevector(w8, w8, 0, 1, 2, 3) | __builtin_shufflevector(w8, w8, 4, 5, 6, 7);
+      w2 = __builtin_shufflevector(w4, w4, 0, 1) | __builtin_shufflevector(w4, w4, 2, 3);
+    } else if constexpr (W == 32) {
+      const auto w4 = __builtin_bit_cast(W4, m);
+      w2 = __builtin_shufflevector(w4, w4, 0, 1) | __builtin_shufflevector(w4, w4, 2, 3);
+    } else {
+      w2 = __builtin_bit_cast(W2, m);
+    }
+    return (w2[0] | w2[1]) != 0;
+  }
+
+  [[gnu::always_inline]] static auto first(UV m) -> usize {
+    auto i = usize(0);
+    while (!m[i]) {
+      ++i;
+    }
+    return i;
+  }
+
+  [[gnu::always_inline]] static auto last(UV m) -> usize {
+    auto i = L - 1;
+    while (!m[i]) {
+      --i;
+    }
+    return i;
+  }
+
+  [[gnu::always_inline]] static auto blend(M m, V a, V b) -> V {
+    return __builtin_bit_cast(V, (m & __builtin_bit_cast(M, a)) | (~m & __builtin_bit_cast(M, b)));
+  }
+
+  [[gnu::always_inline]] static auto hsum(V v) -> T {
+    for (auto w = L / 2; w != 0; w /= 2) {
+      for (usize i = 0; i < w; ++i) {
+        v[i] += v[i + w];
+      }
+    }
+    return v[0];
+  }
+
+  static constexpr auto top() -> T {
+    if constexpr (num::is_flt<T>()) {
+      return __builtin_inf();
+    } else {
+      return num::is_sint<T>() ? T(U(-1) >> 1) : T(-1);
+    }
+  }
+
+  static constexpr auto bottom() -> T {
+    if constexpr (num::is_flt<T>()) {
+      return -__builtin_inf();
+    } else {
+      return num::is_sint<T>() ? T(-top() - 1) : T(0);
+    }
+  }
+
+  // 4 vectors a round, one test for all of them; the round with the match is
+  // then gone over again one vector at a time.
+  [[gnu::always_inline]] static auto find(const T* p, usize n, T val) -> usize {
+    const auto x = V{} + val;
+    auto i = usize(0);
+    for (; i + 4 * L <= n; i += 4 * L) {
+      const auto m = lanes(load(p + i) == x) | lanes(load(p + i + L) == x) | lanes(load(p + i + 2 * L) == x) |
+                     lanes(load(p + i + 3 * L) == x);
+      if (any(m)) {
+        break;
+      }
+    }
+    for (; i + L <= n; i += L) {
+      const auto m = lanes(load(p + i) == x);
+      if (any(m)) {
+        return i + first(m);
+      }
+    }
+    for (; i < n; ++i) {
+      if (p[i] == val) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  [[gnu::always_inline]] static auto rfind(const T* p, usize n, T val) -> usize {
+    const auto x = V{} + val;
+    auto i = n;
+    for (; i >= 4 * L; i -= 4 * L) {
+      const auto q = p + i - 4 * L;
+      const auto m =
+          lanes(load(q) == x) | lanes(load(q + L) == x) | lanes(load(q + 2 * L) == x) | lanes(load(q + 3 * L) == x);
+      if (any(m)) {
+        break;
+      }
+    }
+    for (; i >= L; i -= L) {
+      const auto m = lanes(load(p + i - L) == x);
+      if (any(m)) {
+        return i - L + last(m);
+      }
+    }
+    while (i != 0) {
+      if (p[--i] == val) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  [[gnu::always_inline]] static auto count(const T* p, usize n, T val) -> usize {
+    const auto x = V{} + val;
+    auto res = usize(0);
+    auto i = usize(0);
+    while (i + L <= n) {
+      // a match is all ones, so subtracting it counts one.
+      auto acc = UV{};
+      const auto end = i + cmp::min((n - i) / L, MAX_COUNT) * L;
+      for (; i != end; i += L) {
+        acc -= lanes(load(p + i) == x);
+      }
+      for (usize k = 0; k < L; ++k) {
+        res += acc[k];
+      }
+    }
+    for (; i < n; ++i) {
+      res += p[i] == val;
+    }
+    return res;
+  }
+
+  [[gnu::always_inline]] static auto mismatch(const T* a, const T* b, usize n) -> usize {
+    auto i = usize(0);
+    for (; i + 4 * L <= n; i += 4 * L) {
+      const auto m = lanes(load(a + i) != load(b + i)) | lanes(load(a + i + L) != load(b + i + L)) |
+                     lanes(load(a + i + 2 * L) != load(b + i + 2 * L)) |
+                     lanes(load(a + i + 3 * L) != load(b + i + 3 * L));
+      if (any(m)) {
+        break;
+      }
+    }
+    for (; i + L <= n; i += L) {
+      const auto m = lanes(load(a + i) != load(b + i));
+      if (any(m)) {
+        return i + first(m);
+      }
+    }
+    for (; i < n; ++i) {
+      if (a[i] != b[i]) {
+        return i;
+      }
+    }
+    return n;
+  }
+
+  // `x` beats `y`; false for NaNs either way.
+  template <bool MAX>
+  [[gnu::always_inline]] static auto beats(auto x, auto y) {
+    if constexpr (MAX) {
+      return y < x;
+    } else {
+      return x < y;
+    }
+  }
+
+  template <bool MAX>
+  [[gnu::always_inline]] static auto extreme(const T* p, usize n) -> T {
+    const auto init = MAX ? bottom() : top();
+    auto a0 = V{} + init;
+    auto a1 = a0;
+    auto i = usize(0);
+    for (; i + 2 * L <= n; i += 2 * L) {
+      const auto x0 = load(p + i);
+      const auto x1 = load(p + i + L);
+      a0 = blend(beats<MAX>(x0, a0), x0, a0);
+      a1 = blend(beats<MAX>(x1, a1), x1, a1);
+    }
+    if (i + L <= n) {
+      const auto x0 = load(p + i);
+      a0 = blend(beats<MAX>(x0, a0), x0, a0);
+      i += L;
+    }
+    a0 = blend(beats<MAX>(a1, a0), a1, a0);
+
+    auto res = init;
+    for (usize k = 0; k < L; ++k) {
+      res = beats<MAX>(a0[k], res) ? a0[k] : res;
+    }
+    for (; i < n; ++i) {
+      res = beats<MAX>(p[i], res) ? p[i] : res;
+    }
+    return res;
+  }
+
+  [[gnu::always_inline]] static auto min(const T* p, usize n) -> T {
+    return extreme<false>(p, n);
+  }
+
+  [[gnu::always_inline]] static auto max(const T* p, usize n) -> T {
+    return extreme<true>(p, n);
+  }
+
+  [[gnu::always_inline]] static auto sum_ints(const T* p, usize n) -> T {
+    const auto q = reinterpret_cast<const U*>(p);
+    auto a0 = UV{};
+    auto a1 = UV{};
+    auto i = usize(0);
+    for (; i + 2 * L <= n; i += 2 * L) {
+      UV x0, x1;
+      __builtin_memcpy(&x0, q + i, sizeof(x0));
+      __builtin_memcpy(&x1, q + i + L, sizeof(x1));
+      a0 += x0;
+      a1 += x1;
+    }
+    if (i + L <= n) {
+      UV x0;
+      __builtin_memcpy(&x0, q + i, sizeof(x0));
+      a0 += x0;
+      i += L;
+    }
+    a0 += a1;
+
+    auto res = U(0);
+    for (usize k = 0; k < L; ++k) {
+      res += a0[k];
+    }
+    for (; i < n; ++i) {
+      res += q[i];
+    }
+    return T(res);
+  }
+
+  // `a += p[0..L64]`, register by register.
+  [[gnu::always_inline]] static void add64(V (&a)[R], const T* p) {
+    for (usize r = 0; r < R; ++r) {
+      a[r] += load(p + r * L);
+    }
+  }
+
+  // the halves of the 64-byte vector first, as its own `hsum` would.
+  [[gnu::always_inline]] static auto hsum64(V (&a)[R]) -> T {
+    for (auto w = R / 2; w != 0; w /= 2) {
+      for (usize r = 0; r < w; ++r) {
+        a[r] += a[r + w];
+      }
+    }
+    return hsum(a[0]);
+  }
+
+  // each block in 4 vectors, then the blocks like a binary counter, so the
+  // rounding error grows with log(n).
+  [[gnu::always_inline]] static auto sum_floats(const T* p, usize n) -> T {
+    T part[64];
+    auto cnt = u64(0);
+    const auto push = [&](T x) {
+      auto k = usize(0);
+      for (; (cnt >> k) & 1; ++k) {
+        x = part[k] + x;
+      }
+      part[k] = x;
+      cnt += 1;
+    };
+
+    auto i = usize(0);
+    for (; i + BLOCK <= n; i += BLOCK) {
+      V a[4][R] = {};
+      for (usize j = i; j != i + BLOCK; j += 4 * L64) {
+        add64(a[0], p + j);
+        add64(a[1], p + j + L64);
+        add64(a[2], p + j + 2 * L64);
+        add64(a[3], p + j + 3 * L64);
+      }
+      V b[R];
+      for (usize r = 0; r < R; ++r) {
+        b[r] = (a[0][r] + a[1][r]) + (a[2][r] + a[3][r]);
+      }
+      push(hsum64(b));
+    }
+
+    V a0[R] = {};
+    for (; i + L64 <= n; i += L64) {
+      add64(a0, p + i);
+    }
+    auto t = T(0);
+    for (; i < n; ++i) {
+      t += p[i];
+    }
+    push(hsum64(a0) + t);
+
+    auto res = T(0);
+    for (usize k = 0; k < 64; ++k) {
+      if ((cnt >> k) & 1) {
+        res += part[k];
+      }
+    }
+    return res;
+  }
+
+  [[gnu::always_inline]] static auto sum(const T* p, usize n) -> T {
+    if constexpr (num::is_flt<T>()) {
+      return sum_floats(p, n);
+    } else {
+      return sum_ints(p, n);
+    }
+  }
+};
+
+#if defined(__x86_64__)
+// the plain build is the sse2 clone, sse2 being part of x86-64.
+#define impl_op(T, R, name, params, args)                       \
+  [[sfc_target_avx512]] static auto name##_avx512 params -> R { \
+    return Kernel<T, 64>::name args;                            \
+  }                                                             \
+  [[sfc_target_avx2]] static auto name##_avx2 params -> R {     \
+    return Kernel<T, 32>::name args;                            \
+  }                                                             \
+  auto name params -> R {                                       \
+    switch (cpu::level()) {                                     \
+      case cpu::Level::Avx512: return name##_avx512 args;       \
+      case cpu::Level::Avx2:   return name##_avx2 args;         \
+      default:                 return Kernel<T, 16>::name args; \
+    }                                                           \
+  }
+#else
+#define impl_op(T, R, name, params, args) \
+  auto name params -> R {                 \
+    return Kernel<T, 16>::name args;      \
+  }
+#endif
+
+#define impl_simd(T)                                                                       \
+  impl_op(T, usize, find, (const T* p, usize n, T val), (p, n, val))                       \
+  impl_op(T, usize, rfind, (const T* p, usize n, T val), (p, n, val))                      \
+  impl_op(T, usize, count, (const T* p, usize n, T val), (p, n, val))                      \
+  impl_op(T, usize, mismatch, (const T* a, const T* b, usize n), (a, b, n))                \
+  impl_op(T, T, min, (const T* p, usize n), (p, n))                                        \
+  impl_op(T, T, max, (const T* p, usize n), (p, n))                                        \
+  impl_op(T, T, sum, (const T* p, usize n), (p, n))
+
+impl_simd(i8);
+impl_simd(i16);
+impl_simd(i32);
+impl_simd(i64);
+impl_simd(u8);
+impl_simd(u16);
+impl_simd(u32);
+impl_simd(u64);
+impl_simd(f32);
+impl_simd(f64);
+#undef impl_simd
+#undef impl_op
+
+}  // namespace sfc::ptr::simd
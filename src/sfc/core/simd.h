@@ -0,0 +1,75 @@
+#pragma once
+
+#include "num.h"
+
+// scans over arrays of integers and floats, in the widest registers
+// `cpu::level()` allows: avx-512, avx2 or sse2.
+namespace sfc::ptr::simd {
+
+// below this many items the scalar loops win, the call being out of line.
+static constexpr usize MIN_LEN = 16;
+
+template <class T>
+constexpr auto is_simd() -> bool {
+  return num::is_int<T>() || __is_same(T, f32) || __is_same(T, f64);
+}
+
+template <usize N, bool S>
+struct IntOf;
+
+// clang-format off
+template <> struct IntOf<1, true> { using Type = i8; };
+template <> struct IntOf<2, true> { using Type = i16; };
+template <> struct IntOf<4, true> { using Type = i32; };
+template <> struct IntOf<8, true> { using Type = i64; };
+template <> struct IntOf<1, false> { using Type = u8; };
+template <> struct IntOf<2, false> { using Type = u16; };
+template <> struct IntOf<4, false> { using Type = u32; };
+template <> struct IntOf<8, false> { using Type = u64; };
+// clang-format on
+
+template <class T, class = void>
+struct Canon {
+  using Type = T;
+};
+
+template <class T>
+struct Canon<T, when_t<num::is_int<T>()>> {
+  using Type = typename IntOf<sizeof(T), num::is_sint<T>()>::Type;
+};
+
+// the type with kernels that stands for `T`: `long long` goes as `i64`.
+template <class T>
+using canon_t = typename Canon<T>::Type;
+
+template <class T>
+[[gnu::always_inline]] inline auto canon(const T* p) -> const canon_t<T>* {
+  return reinterpret_cast<const canon_t<T>*>(p);
+}
+
+// `find`, `rfind` and `mismatch` give `n` when there is no such item. `min`
+// and `max` skip NaNs, and give the far end of the range of `T` when left
+// with nothing. `sum` wraps around for integers and adds floats pairwise,
+// in the same order whichever the instruction set.
+#define impl_simd(T)                                            \
+  auto find(const T* p, usize n, T val) -> usize;               \
+  auto rfind(const T* p, usize n, T val) -> usize;              \
+  auto count(const T* p, usize n, T val) -> usize;              \
+  auto mismatch(const T* a, const T* b, usize n) -> usize;      \
+  auto min(const T* p, usize n) -> T;                           \
+  auto max(const T* p, usize n) -> T;                           \
+  auto sum(const T* p, usize n) -> T;
+
+impl_simd(i8);
+impl_simd(i16);
+impl_simd(i32);
+impl_simd(i64);
+impl_simd(u8);
+impl_simd(u16);
+impl_simd(u32);
+impl_simd(u64);
+impl_simd(f32);
+impl_simd(f64);
+#undef impl_simd
+
+}  // namespace sfc::ptr::simd
@@ -5,6 +5,7 @@
 #include "num.h"
 #include "ops.h"
 #include "ptr.h"
+#include "sort.h"
 #include "tuple.h"
 
 namespace sfc::slice {
@@ -109,12 +110,91 @@ struct Slice<const T> {
     return Iter{_ptr, _ptr + _len};
   }
 
+  // integers and floats are scanned a vector at a time, see `ptr::simd`.
   auto find(const T& val) const -> Option<usize> {
-    return this->iter()->find([&](const auto& x) { return x == val; });
+    if constexpr (ptr::simd::is_simd<T>()) {
+      const auto i = ptr::simd::find(ptr::simd::canon(_ptr), _len, ptr::simd::canon_t<T>(val));
+      if (i == _len) return option::NONE;
+      return {option::SOME, i};
+    } else {
+      return this->iter()->find([&](const auto& x) { return x == val; });
+    }
   }
 
   auto rfind(const T& val) const -> Option<usize> {
-    return this->iter()->rfind([&](const auto& x) { return x == val; });
+    if constexpr (ptr::simd::is_simd<T>()) {
+      const auto i = ptr::simd::rfind(ptr::simd::canon(_ptr), _len, ptr::simd::canon_t<T>(val));
+      if (i == _len) return option::NONE;
+      return {option::SOME, i};
+    } else {
+      return this->iter()->rfind([&](const auto& x) { return x == val; });
+    }
+  }
+
+  auto contains(const T& val) const -> bool {
+    return this->find(val).is_some();
+  }
+
+  auto count(const T& val) const -> usize {
+    if constexpr (ptr::simd::is_simd<T>()) {
+      return ptr::simd::count(ptr::simd::canon(_ptr), _len, ptr::simd::canon_t<T>(val));
+    } else {
+      auto res = usize(0);
+      for (usize i = 0; i < _len; ++i) {
+        res += _ptr[i] == val;
+      }
+      return res;
+    }
+  }
+
+  // integers and floats only; NaNs are skipped, so all NaNs give none.
+  auto min() const -> Option<T> {
+    static_assert(ptr::simd::is_simd<T>(), "slice::min: integers and floats only");
+    if (_len == 0) return option::NONE;
+    const auto res = T(ptr::simd::min(ptr::simd::canon(_ptr), _len));
+    if constexpr (num::is_flt<T>()) {
+      if (res == __builtin_inf() && !this->contains(res)) return option::NONE;
+    }
+    return {option::SOME, res};
+  }
+
+  auto max() const -> Option<T> {
+    static_assert(ptr::simd::is_simd<T>(), "slice::max: integers and floats only");
+    if (_len == 0) return option::NONE;
+    const auto res = T(ptr::simd::max(ptr::simd::canon(_ptr), _len));
+    if constexpr (num::is_flt<T>()) {
+      if (res == -__builtin_inf() && !this->contains(res)) return option::NONE;
+    }
+    return {option::SOME, res};
+  }
+
+  // the first index of the smallest item.
+  auto argmin() const -> Option<usize> {
+    return this->min().and_then([&](T x) { return this->find(x); });
+  }
+
+  auto argmax() const -> Option<usize> {
+    return this->max().and_then([&](T x) { return this->find(x); });
+  }
+
+  // integers wrap around; floats are added pairwise.
+  auto sum() const -> T {
+    static_assert(ptr::simd::is_simd<T>(), "slice::sum: integers and floats only");
+    return T(ptr::simd::sum(ptr::simd::canon(_ptr), _len));
+  }
+
+  template <class F>
+  auto is_sorted_by(const F& less) const -> bool {
+    for (usize i = 1; i < _len; ++i) {
+      if (less(_ptr[i], _ptr[i - 1])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto is_sorted() const -> bool {
+    return this->is_sorted_by(slice::sort::Less{});
   }
 
   auto operator==(Slice other) const -> bool {
@@ -124,7 +204,8 @@ struct Slice<const T> {
   auto operator<=>(Slice other) const -> cmp::Ordering {
     const auto n = cmp::min(_len, other._len);
     const auto x = ptr::cmp(_ptr, other._ptr, n);
-    if (x == 0) return cmp::Ordering::Equal;
+    if (x != 0) return x < 0 ? cmp::Ordering::Less : cmp::Ordering::Greater;
+    if (_len == other._len) return cmp::Ordering::Equal;
     return _len < other._len ? cmp::Ordering::Less : cmp::Ordering::Greater;
   }
 };
@@ -225,11 +306,90 @@ struct Slice {
   }
 
   auto find(const T& val) const -> Option<usize> {
-    return this->iter().find([&](const auto& x) { return x == val; });
+    return Const{_ptr, _len}.find(val);
   }
 
   auto rfind(const T& val) const -> Option<usize> {
-    return this->iter().rfind([&](const auto& x) { return x == val; });
+    return Const{_ptr, _len}.rfind(val);
+  }
+
+  auto contains(const T& val) const -> bool {
+    return Const{_ptr, _len}.contains(val);
+  }
+
+  auto count(const T& val) const -> usize {
+    return Const{_ptr, _len}.count(val);
+  }
+
+  auto min() const -> Option<T> {
+    return Const{_ptr, _len}.min();
+  }
+
+  auto max() const -> Option<T> {
+    return Const{_ptr, _len}.max();
+  }
+
+  auto argmin() const -> Option<usize> {
+    return Const{_ptr, _len}.argmin();
+  }
+
+  auto argmax() const -> Option<usize> {
+    return Const{_ptr, _len}.argmax();
+  }
+
+  auto sum() const -> T {
+    return Const{_ptr, _len}.sum();
+  }
+
+  template <class F>
+  auto is_sorted_by(const F& less) const -> bool {
+    for (usize i = 1; i < _len; ++i) {
+      if (less(_ptr[i], _ptr[i - 1])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto is_sorted() const -> bool {
+    return this->is_sorted_by(slice::sort::Less{});
+  }
+
+  // pdqsort: in place and O(n log n) at worst, but equal items may be
+  // reordered. `less(a, b)` says `a` goes before `b`.
+  template <class F>
+  void sort_unstable_by(const F& less) {
+    slice::sort::unstable(_ptr, _len, less);
+  }
+
+  void sort_unstable() {
+    this->sort_unstable_by(slice::sort::Less{});
+  }
+
+  template <class F>
+  void sort_unstable_by_key(const F& key) {
+    this->sort_unstable_by([&](const T& a, const T& b) { return key(a) < key(b); });
+  }
+
+  // stable: a merge sort with a buffer of `len / 2` from `alloc::GLOBAL`.
+  template <class F>
+  void sort_by(const F& less) {
+    slice::sort::stable(_ptr, _len, less);
+  }
+
+  // stable; integers and floats are radix sorted, floats by total order.
+  void sort() {
+    if constexpr (slice::sort::is_radix_key<T>()) {
+      this->sort_by_key([](const T& x) { return x; });
+    } else {
+      this->sort_by(slice::sort::Less{});
+    }
+  }
+
+  // stable; integer and float keys are radix sorted, with a buffer of `len`.
+  template <class F>
+  void sort_by_key(const F& key) {
+    slice::sort::stable_by_key(_ptr, _len, key);
   }
 
   auto operator==(Slice<const T> other) const -> bool {
@@ -239,7 +399,8 @@ struct Slice {
   auto operator<=>(Slice<const T> other) const -> cmp::Ordering {
     const auto n = cmp::min(_len, other._len);
     const auto x = ptr::cmp(_ptr, other._ptr, n);
-    if (x == 0) return cmp::Ordering::Equal;
+    if (x != 0) return x < 0 ? cmp::Ordering::Less : cmp::Ordering::Greater;
+    if (_len == other._len) return cmp::Ordering::Equal;
     return _len < other._len ? cmp::Ordering::Less : cmp::Ordering::Greater;
   }
 };
@@ -0,0 +1,627 @@
+#pragma once
+
+#include "../alloc/alloc.h"
+#include "cmp.h"
+#include "num.h"
+#include "ptr.h"
+#include "tuple.h"
+
+// the algorithms behind `Slice::sort*`, on raw ranges. elements are moved
+// bitwise, like everywhere else in sfc; `less(a, b)` says `a` goes first.
+namespace sfc::slice::sort {
+
+struct Less {
+  template <class T>
+  auto operator()(const T& a, const T& b) const -> bool {
+    return a < b;
+  }
+};
+
+// writes `_src` back into `*_dst` when it goes out of scope, so that a panic
+// in `less` leaves every element in the slice exactly once.
+template <class T>
+struct Gap {
+  mem::Hole<T> _src;
+  T* _dst;
+
+  explicit Gap(T* src) : _dst{src} {
+    ptr::copy(src, &_src._val, 1);
+  }
+
+  ~Gap() {
+    if (_dst != &_src._val) {
+      ptr::copy(&_src._val, _dst, 1);
+    }
+  }
+
+  Gap(const Gap&) = delete;
+};
+
+#pragma region insertion
+// `v[..n-1]` is sorted: moves `v[n-1]` left into place.
+template <class T, class F>
+void insert_tail(T* v, usize n, const F& less) {
+  if (n < 2 || !less(v[n - 1], v[n - 2])) {
+    return;
+  }
+  auto gap = Gap<T>{v + n - 1};
+  ptr::copy(v + n - 2, v + n - 1, 1);
+  gap._dst = v + n - 2;
+  for (auto i = n - 2; i > 0 && less(gap._src._val, v[i - 1]); --i) {
+    ptr::copy(v + i - 1, v + i, 1);
+    gap._dst = v + i - 1;
+  }
+}
+
+// `v[1..]` is sorted: moves `v[0]` right into place.
+template <class T, class F>
+void insert_head(T* v, usize n, const F& less) {
+  if (n < 2 || !less(v[1], v[0])) {
+    return;
+  }
+  auto gap = Gap<T>{v};
+  ptr::copy(v + 1, v, 1);
+  gap._dst = v + 1;
+  for (usize i = 2; i < n && less(v[i], gap._src._val); ++i) {
+    ptr::copy(v + i, v + i - 1, 1);
+    gap._dst = v + i;
+  }
+}
+
+// `v[..offset]` is sorted: sorts all of `v`.
+template <class T, class F>
+void insertion(T* v, usize n, usize offset, const F& less) {
+  for (auto i = cmp::max(offset, usize(1)); i < n; ++i) {
+    sort::insert_tail(v, i + 1, less);
+  }
+}
+#pragma endregion
+
+#pragma region heapsort
+template <class T, class F>
+void sift_down(T* v, usize n, usize node, const F& less) {
+  for (auto child = 2 * node + 1; child < n; child = 2 * node + 1) {
+    if (child + 1 < n && less(v[child], v[child + 1])) {
+      child += 1;
+    }
+    if (!less(v[node], v[child])) {
+      break;
+    }
+    mem::swap(v[node], v[child]);
+    node = child;
+  }
+}
+
+template <class T, class F>
+void heapsort(T* v, usize n, const F& less) {
+  for (auto i = n / 2; i > 0; --i) {
+    sort::sift_down(v, n, i - 1, less);
+  }
+  for (auto i = n; i > 1; --i) {
+    mem::swap(v[0], v[i - 1]);
+    sort::sift_down(v, i - 1, 0, less);
+  }
+}
+#pragma endregion
+
+#pragma region pdqsort
+static constexpr usize MAX_INSERTION = 20;
+
+// moves the items `pred(x)` holds for to the front, and returns how many
+// there are. there is no branch on `pred`: every step moves one item into
+// the gap left by the last one, and only the count depends on the result.
+template <class T, class P>
+auto partition_lomuto(T* v, usize n, const P& pred) -> usize {
+  if (n == 0) {
+    return 0;
+  }
+
+  auto gap = Gap<T>{v};
+  auto cnt = usize(0);
+  const auto step = [&](T* right) {
+    const auto is_left = pred(*right);
+    ptr::move(v + cnt, gap._dst, 1);  // the same slot on the first step
+    ptr::copy(right, v + cnt, 1);
+    gap._dst = right;
+    cnt += usize(is_left);
+  };
+  for (auto right = v + 1; right < v + n; ++right) {
+    step(right);
+  }
+  step(&gap._src._val);
+  return cnt;
+}
+
+// partitions around `v[pivot]`, and returns where the pivot ended up and
+// whether nothing had to move.
+template <class T, class F>
+auto partition(T* v, usize n, usize pivot, const F& less) -> Tuple<usize, bool> {
+  mem::swap(v[0], v[pivot]);
+  const auto& p = v[0];
+  const auto rest = v + 1;
+
+  auto l = usize(0);
+  auto r = n - 1;
+  while (l < r && less(rest[l], p)) {
+    l += 1;
+  }
+  while (l < r && !less(rest[r - 1], p)) {
+    r -= 1;
+  }
+  const auto mid = l + sort::partition_lomuto(rest + l, r - l, [&](const T& x) { return less(x, p); });
+  mem::swap(v[0], v[mid]);
+  return {mid, l >= r};
+}
+
+// puts the items equal to `v[pivot]` first, for when no item can be smaller;
+// returns how many, the pivot included.
+template <class T, class F>
+auto partition_equal(T* v, usize n, usize pivot, const F& less) -> usize {
+  mem::swap(v[0], v[pivot]);
+  const auto& p = v[0];
+  const auto rest = v + 1;
+  return 1 + sort::partition_lomuto(rest, n - 1, [&](const T& x) { return !less(p, x); });
+}
+
+// median of three, or of three medians for long slices; also says whether
+// the slice looks sorted already. one that looks reversed is reversed.
+template <class T, class F>
+auto choose_pivot(T* v, usize n, const F& less) -> Tuple<usize, bool> {
+  static constexpr usize SHORTEST_NINTHER = 50;
+  static constexpr usize MAX_SWAPS = 4 * 3;
+
+  auto a = n / 4 * 1;
+  auto b = n / 4 * 2;
+  auto c = n / 4 * 3;
+  auto swaps = usize(0);
+
+  const auto sort2 = [&](usize& x, usize& y) {
+    if (less(v[y], v[x])) {
+      mem::swap(x, y);
+      swaps += 1;
+    }
+  };
+  const auto sort3 = [&](usize& x, usize& y, usize& z) {
+    sort2(x, y);
+    sort2(y, z);
+    sort2(x, y);
+  };
+
+  if (n >= 8) {
+    if (n >= SHORTEST_NINTHER) {
+      const auto adjacent = [&](usize& x) {
+        auto lo = x - 1;
+        auto hi = x + 1;
+        sort3(lo, x, hi);
+      };
+      adjacent(a);
+      adjacent(b);
+      adjacent(c);
+    }
+    sort3(a, b, c);
+  }
+
+  if (swaps < MAX_SWAPS) {
+    return {b, swaps == 0};
+  }
+  for (usize i = 0; i < n / 2; ++i) {
+    mem::swap(v[i], v[n - 1 - i]);
+  }
+  return {n - 1 - b, true};
+}
+
+// fixes a nearly sorted slice with a few shifts; gives up, returning false,
+// when that would take too many.
+template <class T, class F>
+auto partial_insertion(T* v, usize n, const F& less) -> bool {
+  static constexpr usize MAX_STEPS = 5;
+  static constexpr usize SHORTEST_SHIFTING = 50;
+
+  auto i = usize(1);
+  for (usize step = 0; step < MAX_STEPS; ++step) {
+    while (i < n && !less(v[i], v[i - 1])) {
+      i += 1;
+    }
+    if (i == n) {
+      return true;
+    }
+    if (n < SHORTEST_SHIFTING) {
+      return false;
+    }
+    mem::swap(v[i - 1], v[i]);
+    sort::insert_tail(v, i, less);
+    sort::insert_head(v + i, n - i, less);
+  }
+  return false;
+}
+
+// swaps a few items around the middle, after a bad pivot: patterns that
+// make the pivot choice fail once are unlikely to survive this.
+template <class T>
+void break_patterns(T* v, usize n) {
+  if (n < 8) {
+    return;
+  }
+  auto seed = u64(n);
+  const auto mask = (usize(1) << (64 - num::clz(u64(n - 1)))) - 1;
+  const auto pos = n / 4 * 2;
+  for (usize i = 0; i < 3; ++i) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    auto other = usize(seed) & mask;
+    if (other >= n) {
+      other -= n;
+    }
+    mem::swap(v[pos - 1 + i], v[other]);
+  }
+}
+
+// `pred`, when not null, is an item no greater than any in `v`: the pivot
+// of an ancestor partition, for the fast path on many equal items.
+template <class T, class F>
+void pdqsort(T* v, usize n, const F& less, const T* pred, u32 limit) {
+  auto was_balanced = true;
+  auto was_partitioned = true;
+
+  while (true) {
+    if (n <= MAX_INSERTION) {
+      sort::insertion(v, n, 1, less);
+      return;
+    }
+    if (limit == 0) {
+      sort::heapsort(v, n, less);
+      return;
+    }
+    if (!was_balanced) {
+      sort::break_patterns(v, n);
+      limit -= 1;
+    }
+
+    const auto [pivot, likely_sorted] = sort::choose_pivot(v, n, less);
+    if (was_balanced && was_partitioned && likely_sorted && sort::partial_insertion(v, n, less)) {
+      return;
+    }
+
+    if (pred != nullptr && !less(*pred, v[pivot])) {
+      const auto mid = sort::partition_equal(v, n, pivot, less);
+      v += mid;
+      n -= mid;
+      continue;
+    }
+
+    const auto [mid, was_p] = sort::partition(v, n, pivot, less);
+    was_balanced = cmp::min(mid, n - mid) >= n / 8;
+    was_partitioned = was_p;
+
+    // recurses into the shorter side and loops on the longer.
+    const auto left = v;
+    const auto right = v + mid + 1;
+    const auto right_len = n - mid - 1;
+    if (mid < right_len) {
+      sort::pdqsort(left, mid, less, pred, limit);
+      pred = v + mid;
+      v = right;
+      n = right_len;
+    } else {
+      sort::pdqsort(right, right_len, less, v + mid, limit);
+      n = mid;
+    }
+  }
+}
+
+template <class T, class F>
+void unstable(T* v, usize n, const F& less) {
+  if (n < 2) {
+    return;
+  }
+  const auto limit = u32(64 - num::clz(u64(n)));
+  sort::pdqsort(v, n, less, static_cast<const T*>(nullptr), limit);
+}
+#pragma endregion
+
+#pragma region merge
+// merges the sorted runs `v[..mid]` and `v[mid..n]` in place, through `buf`
+// which holds the shorter of them.
+template <class T, class F>
+void merge(T* v, usize n, usize mid, T* buf, const F& less) {
+  // whatever is left in `[_start, _end)` belongs at `_dst`.
+  struct Hole {
+    T* _start;
+    T* _end;
+    T* _dst;
+
+    ~Hole() {
+      ptr::copy(_start, _dst, usize(_end - _start));
+    }
+  };
+
+  if (mid <= n - mid) {
+    ptr::copy(v, buf, mid);
+    auto hole = Hole{buf, buf + mid, v};
+    auto right = v + mid;
+    while (hole._start < hole._end && right < v + n) {
+      const auto take_right = less(*right, *hole._start);
+      ptr::copy(take_right ? right : hole._start, hole._dst, 1);
+      hole._dst += 1;
+      right += usize(take_right);
+      hole._start += usize(!take_right);
+    }
+  } else {
+    ptr::copy(v + mid, buf, n - mid);
+    auto hole = Hole{buf, buf + (n - mid), v + mid};
+    auto out = v + n;
+    while (v < hole._dst && buf < hole._end) {
+      const auto take_left = less(hole._end[-1], hole._dst[-1]);
+      hole._dst -= usize(take_left);
+      hole._end -= usize(!take_left);
+      out -= 1;
+      ptr::copy(take_left ? hole._dst : hole._end, out, 1);
+    }
+  }
+}
+
+// the length of the run at the start of `v`; a strictly descending one is
+// reversed first, which keeps equal items in order.
+template <class T, class F>
+auto find_run(T* v, usize n, const F& less) -> usize {
+  if (n < 2) {
+    return n;
+  }
+  auto end = usize(2);
+  if (!less(v[1], v[0])) {
+    while (end < n && !less(v[end], v[end - 1])) {
+      end += 1;
+    }
+    return end;
+  }
+  while (end < n && less(v[end], v[end - 1])) {
+    end += 1;
+  }
+  for (usize i = 0; i < end / 2; ++i) {
+    mem::swap(v[i], v[end - 1 - i]);
+  }
+  return end;
+}
+
+struct Run {
+  usize _start;
+  usize _len;
+};
+
+// the run to merge with the one after it, keeping run lengths growing like
+// fibonacci numbers downward, as timsort does; -1 for none.
+inline auto collapse(const Run* runs, usize cnt, usize stop) -> isize {
+  if (cnt < 2) {
+    return -1;
+  }
+  const auto n = cnt;
+  const auto must = runs[n - 1]._start + runs[n - 1]._len == stop ||  // the last run
+                    runs[n - 2]._len <= runs[n - 1]._len ||
+                    (n >= 3 && runs[n - 3]._len <= runs[n - 2]._len + runs[n - 1]._len) ||
+                    (n >= 4 && runs[n - 4]._len <= runs[n - 3]._len + runs[n - 2]._len);
+  if (!must) {
+    return -1;
+  }
+  return n >= 3 && runs[n - 3]._len < runs[n - 1]._len ? isize(n - 3) : isize(n - 2);
+}
+
+// frees the scratch buffer, moved out of or not.
+template <class T>
+struct Buf {
+  T* _ptr;
+  usize _len;
+
+  explicit Buf(usize len) : _ptr{alloc::GLOBAL.alloc_array<T>(len)}, _len{len} {}
+
+  ~Buf() {
+    alloc::GLOBAL.dealloc_array(_ptr, _len);
+  }
+
+  Buf(const Buf&) = delete;
+};
+
+// timsort: finds the natural runs, makes short ones `MIN_RUN` long with an
+// insertion sort, and merges them through a buffer of `n / 2`.
+template <class T, class F>
+void stable(T* v, usize n, const F& less) {
+  static constexpr usize MIN_RUN = 10;
+  static constexpr usize MAX_RUNS = 128;  // timsort needs ~log(n, 1.6)
+
+  if (n <= MAX_INSERTION) {
+    sort::insertion(v, n, 1, less);
+    return;
+  }
+
+  auto buf = Buf<T>{n / 2};
+  Run runs[MAX_RUNS];
+  auto cnt = usize(0);
+  for (auto start = usize(0); start < n;) {
+    auto end = start + sort::find_run(v + start, n - start, less);
+    if (end < n && end - start < MIN_RUN) {
+      const auto new_end = cmp::min(start + MIN_RUN, n);
+      sort::insertion(v + start, new_end - start, end - start, less);
+      end = new_end;
+    }
+    runs[cnt++] = Run{start, end - start};
+    start = end;
+
+    for (auto r = sort::collapse(runs, cnt, n); r >= 0; r = sort::collapse(runs, cnt, n)) {
+      const auto left = runs[r];
+      const auto right = runs[r + 1];
+      sort::merge(v + left._start, left._len + right._len, left._len, buf._ptr, less);
+      runs[r] = Run{left._start, left._len + right._len};
+      for (auto k = usize(r) + 1; k + 1 < cnt; ++k) {
+        runs[k] = runs[k + 1];
+      }
+      cnt -= 1;
+    }
+  }
+}
+
+// merges the sorted `a` and `b` into `out`, taking from `a` on ties.
+template <class T, class F>
+void merge_into(const T* a, usize na, const T* b, usize nb, T* out, const F& less) {
+  const auto ea = a + na;
+  const auto eb = b + nb;
+  while (a < ea && b < eb) {
+    const auto take_b = less(*b, *a);
+    ptr::copy(take_b ? b : a, out++, 1);
+    b += usize(take_b);
+    a += usize(!take_b);
+  }
+  ptr::copy(a, out, usize(ea - a));
+  ptr::copy(b, out + (ea - a), usize(eb - b));
+}
+
+// how many of the first `k` items of `merge_into(a, b)` come from `a`.
+template <class T, class F>
+auto co_rank(usize k, const T* a, usize na, const T* b, usize nb, const F& less) -> usize {
+  auto lo = k > nb ? k - nb : 0;
+  auto hi = cmp::min(k, na);
+  while (lo < hi) {
+    const auto i = lo + (hi - lo) / 2;  // i < hi <= na, and j = k - i > 0
+    const auto j = k - i;
+    if (j <= nb && less(b[j - 1], a[i])) {
+      hi = i;
+    } else {
+      lo = i + 1;
+    }
+  }
+  return lo;
+}
+#pragma endregion
+
+#pragma region radix
+// integers and floats are sorted by their bits, mapped so that unsigned
+// order is the key order: floats by total order, -nan < -inf < -0 < +0 <
+// inf < nan.
+template <class K>
+constexpr auto is_radix_key() -> bool {
+  return num::is_int<K>() || __is_same(K, f32) || __is_same(K, f64);
+}
+
+template <usize N>
+struct RadixBits;
+
+template <>
+struct RadixBits<1> {
+  using Type = u8;
+};
+
+template <>
+struct RadixBits<2> {
+  using Type = u16;
+};
+
+template <>
+struct RadixBits<4> {
+  using Type = u32;
+};
+
+template <>
+struct RadixBits<8> {
+  using Type = u64;
+};
+
+template <class K>
+[[gnu::always_inline]] inline auto radix_bits(K key) {
+  using U = typename RadixBits<sizeof(K)>::Type;
+  static constexpr auto SIGN = U(U(1) << (sizeof(U) * 8 - 1));
+  if constexpr (num::is_uint<K>()) {
+    return U(key);
+  } else if constexpr (num::is_sint<K>()) {
+    return U(U(key) ^ SIGN);
+  } else {
+    const auto bits = __builtin_bit_cast(U, key);
+    return U(bits & SIGN ? ~bits : bits | SIGN);
+  }
+}
+
+// `cnts[pass][digit]`: how many keys have that byte.
+template <class T, class G>
+void radix_counts(const T* v, usize n, const G& key, usize (*cnts)[256]) {
+  using U = decltype(sort::radix_bits(key(v[0])));
+  for (usize i = 0; i < n; ++i) {
+    const auto bits = sort::radix_bits(key(v[i]));
+    for (usize p = 0; p < sizeof(U); ++p) {
+      cnts[p][(bits >> (8 * p)) & 0xFF] += 1;
+    }
+  }
+}
+
+// a pass that would not move anything: every key has the same byte.
+inline auto radix_skip(const usize* cnts, usize n) -> bool {
+  for (usize d = 0; d < 256; ++d) {
+    if (cnts[d] != 0) {
+      return cnts[d] == n;
+    }
+  }
+  return true;
+}
+
+// lsd radix sort, a byte per pass, through `buf` of `n` items; a pass every
+// key agrees on is skipped. stable.
+template <class T, class G>
+void radix(T* v, usize n, T* buf, const G& key) {
+  using U = decltype(sort::radix_bits(key(v[0])));
+  static constexpr usize PASSES = sizeof(U);
+
+  usize cnts[PASSES][256] = {};
+  sort::radix_counts(v, n, key, cnts);
+
+  // if `key` panics half way through a pass, `src` still holds every item.
+  struct Guard {
+    T* _src;
+    T* _v;
+    usize _n;
+
+    ~Guard() {
+      if (_src != _v) {
+        ptr::copy(_src, _v, _n);
+      }
+    }
+  };
+
+  auto guard = Guard{v, v, n};
+  auto dst = buf;
+  for (usize p = 0; p < PASSES; ++p) {
+    if (sort::radix_skip(cnts[p], n)) {
+      continue;
+    }
+    usize offs[256];
+    for (usize d = 0, sum = 0; d < 256; ++d) {
+      offs[d] = sum;
+      sum += cnts[p][d];
+    }
+    const auto src = guard._src;
+    for (usize i = 0; i < n; ++i) {
+      const auto d = (sort::radix_bits(key(src[i])) >> (8 * p)) & 0xFF;
+      ptr::copy(src + i, dst + offs[d]++, 1);
+    }
+    guard._src = dst;
+    dst = src;
+  }
+}
+
+// below this many items, merging beats the radix passes.
+static constexpr usize RADIX_MIN_LEN = 256;
+
+template <class T, class G>
+void stable_by_key(T* v, usize n, const G& key) {
+  using K = remove_const_t<remove_ref_t<decltype(key(*v))>>;
+  if constexpr (sort::is_radix_key<K>()) {
+    if (n >= RADIX_MIN_LEN) {
+      auto buf = Buf<T>{n};
+      sort::radix(v, n, buf._ptr, key);
+      return;
+    }
+    // the same order as the radix passes, NaNs and -0 included.
+    sort::stable(v, n, [&](const T& a, const T& b) { return sort::radix_bits(key(a)) < sort::radix_bits(key(b)); });
+  } else {
+    sort::stable(v, n, [&](const T& a, const T& b) { return key(a) < key(b); });
+  }
+}
+#pragma endregion
+
+}  // namespace sfc::slice::sort
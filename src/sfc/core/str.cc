@@ -118,7 +118,7 @@ auto CharPredSearcher::next_back() -> Option<bool> {
 auto CharPredSearcher::next_match() -> Option<usize> {
   while (auto&& x = this->next()) {
     if (~x) {
-      return {option::SOME, this->_finger};
+      return {option::SOME, this->_finger - 1};
     }
   }
   return option::NONE;
@@ -156,9 +156,22 @@ auto StrSearcher::next_back() -> Option<bool> {
 }
 
 auto StrSearcher::next_match() -> Option<usize> {
+  // only where the first byte matches is worth a compare.
+  if (!_pattern.is_empty()) {
+    const auto p = _haystack.as_ptr();
+    const auto c = _pattern.as_ptr()[0];
+    while (_finger < _finger_back) {
+      _finger += ptr::simd::find(p + _finger, _finger_back - _finger, c);
+      if (auto x = this->next(); x && ~x) {
+        return {option::SOME, _finger - 1};
+      }
+    }
+    return option::NONE;
+  }
+
   while (auto&& x = this->next()) {
     if (~x) {
-      return {option::SOME, this->_finger};
+      return {option::SOME, this->_finger - 1};
     }
   }
   return option::NONE;
@@ -75,7 +75,7 @@ struct FixedCStr {
   char _buf[CAPACITY];
   usize _len;
 
-  FixedCStr(Str s) : _len{cmp::min(CAPACITY, s.len())} {
+  FixedCStr(Str s) : _len{cmp::min(CAPACITY - 1, s.len())} {
     intrin::copy(s.as_ptr(), ptr::cast<u8>(_buf), _len);
     _buf[_len] = 0;
   }
@@ -176,12 +176,18 @@ auto Str::ends_with(const auto& pattern) const -> bool {
 }
 
 auto Str::find(const auto& pattern) const -> Option<usize> {
+  if constexpr (__is_same(decltype(pattern), const char&)) {
+    return _inn.find(u8(pattern));
+  }
   auto p = Pattern{pattern};
   auto s = p.searcher(*this);
   return s.next_match();
 }
 
 auto Str::rfind(const auto& pattern) const -> Option<usize> {
+  if constexpr (__is_same(decltype(pattern), const char&)) {
+    return _inn.rfind(u8(pattern));
+  }
   auto p = Pattern{pattern};
   auto s = p.searcher(*this);
   return s.next_match_back();
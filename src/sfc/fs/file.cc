@@ -29,6 +29,34 @@ auto OpenOptions::create_new(bool value) -> OpenOptions& {
   return *this;
 }
 
+auto File::create(Path p) -> File {
+  return OpenOptions{}.write(true).create(true).truncate(true).open(p.as_str());
+}
+
+auto File::open(Path p) -> File {
+  return OpenOptions{}.read(true).open(p.as_str());
+}
+
+auto Mmap::as_ptr() const -> const u8* {
+  return _ptr;
+}
+
+auto Mmap::as_mut_ptr() -> u8* {
+  return _ptr;
+}
+
+auto Mmap::len() const -> usize {
+  return _len;
+}
+
+auto Mmap::as_bytes() const -> Slice<const u8> {
+  return {_ptr, _len};
+}
+
+auto Mmap::as_mut_bytes() -> Slice<u8> {
+  return {_ptr, _len};
+}
+
 auto File::operator->() -> io::Write<io::Read<File>>* {
   return reinterpret_cast<io::Write<io::Read<File>>*>(this);
 }
@@ -27,10 +27,31 @@ struct File {
   auto read(Slice<u8> buf) -> usize;
   auto write(Slice<const u8> buf) -> usize;
 
+  auto len() const -> u64;
+  void set_len(u64 size);
+
   auto operator->() -> io::Write<io::Read<File>>*;
 };
 
-struct Mmap {};
+// a shared mapping of part of a file; stores go straight to the page cache.
+struct Mmap {
+  u8* _ptr;
+  usize _len;
+
+  Mmap(u8* ptr, usize len) noexcept;
+  ~Mmap();
+  Mmap(Mmap&& other) noexcept;
+
+  auto as_ptr() const -> const u8*;
+  auto as_mut_ptr() -> u8*;
+  auto len() const -> usize;
+
+  auto as_bytes() const -> Slice<const u8>;
+  auto as_mut_bytes() -> Slice<u8>;
+
+  // writes dirty pages back to the file, and waits for it.
+  void flush();
+};
 
 struct OpenOptions {
   bool _read = false;
@@ -50,6 +71,9 @@ struct OpenOptions {
   auto access_mode() const -> u32;
 
   auto open(Str path) const -> File;
+
+  // `size == 0` maps up to the end of the file; a writable mapping grows the
+  // file to `offset + size`. `offset` must be a multiple of the page size.
   auto mmap(Str path, usize size, usize offset) const -> Mmap;
 };
 
@@ -3,6 +3,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <stdlib.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -61,6 +62,43 @@ auto File::write(Slice<const u8> buf) -> usize {
   return usize(res);
 }
 
+auto File::len() const -> u64 {
+  struct ::stat st = {};
+  if (::fstat(_fid, &st) != 0) {
+    throw io::Error::last_os_error();
+  }
+  return u64(st.st_size);
+}
+
+void File::set_len(u64 size) {
+  if (::ftruncate(_fid, off_t(size)) != 0) {
+    throw io::Error::last_os_error();
+  }
+}
+
+Mmap::Mmap(u8* ptr, usize len) noexcept : _ptr{ptr}, _len{len} {}
+
+Mmap::Mmap(Mmap&& other) noexcept : _ptr{other._ptr}, _len{other._len} {
+  other._ptr = nullptr;
+  other._len = 0;
+}
+
+Mmap::~Mmap() {
+  if (_ptr == nullptr) {
+    return;
+  }
+  ::munmap(_ptr, _len);
+}
+
+void Mmap::flush() {
+  if (_ptr == nullptr) {
+    return;
+  }
+  if (::msync(_ptr, _len, MS_SYNC) != 0) {
+    throw io::Error::last_os_error();
+  }
+}
+
 auto OpenOptions::access_mode() const -> u32 {
   if (!_append) {
     if (_read && !_write) return O_RDONLY;
@@ -91,6 +129,38 @@ auto OpenOptions::open(Str path) const -> File {
   return File{fid};
 }
 
+auto OpenOptions::mmap(Str path, usize size, usize offset) const -> Mmap {
+  // a mapping is never write-only.
+  auto opts = *this;
+  opts._read = true;
+  opts._append = false;
+  auto file = opts.open(path);
+
+  const auto file_len = file.len();
+  if (size == 0) {
+    size = file_len > offset ? usize(file_len - offset) : 0u;
+  } else if (_write && file_len < offset + size) {
+    file.set_len(offset + size);
+  }
+  if (size == 0) {
+    return Mmap{nullptr, 0};
+  }
+
+  const auto prot = PROT_READ | (_write ? PROT_WRITE : 0);
+  const auto ptr = ::mmap(nullptr, size, prot, MAP_SHARED, file._fid, off_t(offset));
+  if (ptr == MAP_FAILED) {
+    throw io::Error::last_os_error();
+  }
+  return Mmap{static_cast<u8*>(ptr), size};
+}
+
+void remove_file(Path path) {
+  const auto os_path = os::PathStr(path.as_str());
+  if (::unlink(os_path) != 0) {
+    throw io::Error::last_os_error();
+  }
+}
+
 auto Metadata::len() const -> u64 {
   return _size;
 }
@@ -11,7 +11,7 @@ auto Path::parent() const -> Path {
     return Path{""};
   }
 
-  const auto xpos = _inner.find('/').unwrap_or(0);
+  const auto xpos = _inner.rfind('/').unwrap_or(0);
   return Path{_inner[{0, xpos}]};
 }
 
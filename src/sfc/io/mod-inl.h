@@ -23,7 +23,7 @@ auto Read<Self>::read_to_end(Vec<u8>& buf, usize buf_size) -> usize {
     const auto read_buf = Slice{buf.as_mut_ptr() + buf.len(), buf_size};
     const auto read_cnt = this->read(read_buf);
     if (read_cnt == 0) {
-      throw Error::UnexpectedEof;
+      break;
     }
     buf.set_len(buf.len() + read_cnt);
   }
@@ -46,7 +46,7 @@ static auto get_info(Level level) -> LevelInfo {
   return LevelInfo{"", ""};
 }
 
-static auto _proc_start = time::System::now();
+static auto _proc_start = time::System::now_coarse();
 
 void Console::entry(Entry entry) const {
   static const auto cols = io::Stdout().winsize().cols;
@@ -29,7 +29,7 @@ static auto get_info(Level level) -> LevelInfo {
   return LevelInfo{""};
 }
 
-static auto _proc_start = time::System::now();
+static auto _proc_start = time::System::now_coarse();
 
 auto File::create(fs::Path p) -> File {
   return File{fs::File::create(p)};
@@ -17,7 +17,7 @@ void Logger::set_level(Level level) {
 }
 
 void Logger::write_str(Level level, Str msg) {
-  auto tnow = time::System::now();
+  auto tnow = time::System::now_coarse();
   auto item = Entry{level, msg, tnow};
   _backends.iter_mut()->for_each([=](BoxBe& backend) { (*backend)(item); });
 }
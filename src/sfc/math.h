@@ -6,3 +6,7 @@
 
 #include "math/map.h"
 #include "math/reduce.h"
+
+#include "math/gemm.h"
+#include "math/mmap.h"
+#include "math/par.h"
@@ -4,31 +4,44 @@
 
 namespace sfc::math {
 
-#define impl_uop(F, ...)         \
-  struct F {                     \
-    template <class T>           \
-    auto operator()(T t) const { \
-      return __VA_ARGS__;        \
-    }                            \
+#define impl_uop(F, ...)                                                \
+  struct F {                                                            \
+    template <class T>                                                  \
+    auto operator()(T t) const -> remove_ref_t<decltype(__VA_ARGS__)> { \
+      return __VA_ARGS__;                                               \
+    }                                                                   \
   }
 impl_uop(Pos, +t);
 impl_uop(Neg, -t);
 #undef impl_uop
 
-#define impl_bop(F, ...)              \
-  struct F {                          \
-    template <class A, class B>       \
-    auto operator()(A a, B b) const { \
-      return __VA_ARGS__;             \
-    }                                 \
+#define impl_bop(F, ...)                                                     \
+  struct F {                                                                 \
+    template <class A, class B>                                              \
+    auto operator()(A a, B b) const -> remove_ref_t<decltype(__VA_ARGS__)> { \
+      return __VA_ARGS__;                                                    \
+    }                                                                        \
   }
 
-impl_bop(Eq, a == b);
-impl_bop(Ne, a != b);
-impl_bop(Lt, a < b);
-impl_bop(Gt, a > b);
-impl_bop(Le, a <= b);
-impl_bop(Ge, a >= b);
+namespace imp {
+// a packet comparison is all ones where it holds: 1 instead, as a `bool` would
+// give, so that packets store and add up like the items.
+inline auto truth(bool x) -> bool {
+  return x;
+}
+
+template <class M>
+inline auto truth(M m) -> M {
+  return -m;
+}
+}  // namespace imp
+
+impl_bop(Eq, imp::truth(a == b));
+impl_bop(Ne, imp::truth(a != b));
+impl_bop(Lt, imp::truth(a < b));
+impl_bop(Gt, imp::truth(a > b));
+impl_bop(Le, imp::truth(a <= b));
+impl_bop(Ge, imp::truth(a >= b));
 
 impl_bop(Add, a + b);
 impl_bop(Sub, a - b);
@@ -65,18 +78,35 @@ impl_ass(ModAssign, y %= x);
     }                                     \
   }
 
+// packet overloads: polynomial kernels in simd.h.
+#define impl_fn1_simd(F, fn)                                        \
+  struct F {                                                        \
+    auto operator()(f32 t) const -> f32 {                           \
+      return __builtin_##fn##f(t);                                  \
+    }                                                               \
+    auto operator()(f64 t) const -> f64 {                           \
+      return __builtin_##fn(t);                                     \
+    }                                                               \
+    auto operator()(simd::vec_t<f32> t) const -> simd::vec_t<f32> { \
+      return simd::fn(t);                                           \
+    }                                                               \
+    auto operator()(simd::vec_t<f64> t) const -> simd::vec_t<f64> { \
+      return simd::fn(t);                                           \
+    }                                                               \
+  }
+
 impl_fn1(Fabs, fabs);
 impl_fn1(Sqrt, sqrt);
 impl_fn1(Cbrt, cbrt);
-impl_fn1(Exp, exp);
+impl_fn1_simd(Exp, exp);
 impl_fn1(Exp2, exp2);
-impl_fn1(Log, log);
+impl_fn1_simd(Log, log);
 impl_fn1(Log2, log2);
 impl_fn1(Log10, log10);
 impl_fn1(Log1p, log1p);
 
-impl_fn1(Sin, sin);
-impl_fn1(Cos, cos);
+impl_fn1_simd(Sin, sin);
+impl_fn1_simd(Cos, cos);
 impl_fn1(Tan, tan);
 
 impl_fn1(ASin, asin);
@@ -85,12 +115,13 @@ impl_fn1(ATan, atan);
 
 impl_fn1(SinH, sinh);
 impl_fn1(CosH, cosh);
-impl_fn1(TanH, tanh);
+impl_fn1_simd(TanH, tanh);
 
 impl_fn1(ASinH, asinh);
 impl_fn1(ACosH, acosh);
 impl_fn1(ATanH, atanh);
 
 #undef impl_fn1
+#undef impl_fn1_simd
 
 }  // namespace sfc::math
@@ -0,0 +1,74 @@
+#include "gemm.h"
+
+namespace sfc::math::imp {
+
+// everything below is inlined into each target clone, so that the packets
+// live in the widest registers the cpu has.
+template <class T>
+[[gnu::always_inline]] inline void gemm_tile(usize kc, const T* a, const T* b, T* c, usize rs, usize cs, usize mr,
+                                             usize nr, T alpha, T beta) {
+  using V = simd::vec_t<T>;
+  constexpr auto MR = GemmBlocks<T>::MR;
+  constexpr auto NR = GemmBlocks<T>::NR;
+
+  V acc[MR] = {};
+  for (usize p = 0; p < kc; ++p) {
+    V bv;
+    __builtin_memcpy(&bv, b + p * NR, sizeof(V));
+    for (usize r = 0; r < MR; ++r) {
+      acc[r] += a[p * MR + r] * bv;
+    }
+  }
+
+  if (mr == MR && nr == NR && cs == 1) {
+    for (usize r = 0; r < MR; ++r) {
+      auto y = alpha * acc[r];
+      if (beta != T(0)) {
+        V x;
+        __builtin_memcpy(&x, c + r * rs, sizeof(V));
+        y += beta * x;
+      }
+      __builtin_memcpy(c + r * rs, &y, sizeof(V));
+    }
+    return;
+  }
+
+  for (usize r = 0; r < mr; ++r) {
+    for (usize j = 0; j < nr; ++j) {
+      auto& y = c[r * rs + j * cs];
+      y = beta == T(0) ? alpha * acc[r][j] : alpha * acc[r][j] + beta * y;
+    }
+  }
+}
+
+#if defined(__x86_64__)
+#define impl_kernel(T)                                                                                             \
+  [[sfc_target_avx512]] static void gemm_kernel_avx512(usize kc, const T* a, const T* b, T* c, usize rs, usize cs, \
+                                                      usize mr, usize nr, T alpha, T beta) {                       \
+    gemm_tile(kc, a, b, c, rs, cs, mr, nr, alpha, beta);                                                           \
+  }                                                                                                                \
+  [[sfc_target_avx2]] static void gemm_kernel_avx2(usize kc, const T* a, const T* b, T* c, usize rs, usize cs,     \
+                                                  usize mr, usize nr, T alpha, T beta) {                           \
+    gemm_tile(kc, a, b, c, rs, cs, mr, nr, alpha, beta);                                                           \
+  }                                                                                                                \
+  void gemm_kernel(usize kc, const T* a, const T* b, T* c, usize rs, usize cs, usize mr, usize nr, T alpha,        \
+                   T beta) {                                                                                       \
+    switch (cpu::level()) {                                                                                        \
+      case cpu::Level::Avx512: return gemm_kernel_avx512(kc, a, b, c, rs, cs, mr, nr, alpha, beta);                \
+      case cpu::Level::Avx2:   return gemm_kernel_avx2(kc, a, b, c, rs, cs, mr, nr, alpha, beta);                  \
+      default:                 return gemm_tile(kc, a, b, c, rs, cs, mr, nr, alpha, beta);                         \
+    }                                                                                                              \
+  }
+#else
+#define impl_kernel(T)                                                                                      \
+  void gemm_kernel(usize kc, const T* a, const T* b, T* c, usize rs, usize cs, usize mr, usize nr, T alpha, \
+                   T beta) {                                                                                \
+    gemm_tile(kc, a, b, c, rs, cs, mr, nr, alpha, beta);                                                    \
+  }
+#endif
+
+impl_kernel(f32);
+impl_kernel(f64);
+#undef impl_kernel
+
+}  // namespace sfc::math::imp
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "../thread/job.h"
+#include "ndarray.h"
+
+namespace sfc::math {
+
+namespace imp {
+
+// MR x NR register tile, MC x KC panel of `a`, KC x NC panel of `b`.
+template <class T>
+struct GemmBlocks {
+  static constexpr usize MR = 6;
+  static constexpr usize NR = simd::lanes<T>;
+  static constexpr usize KC = 1024 / sizeof(T);
+  static constexpr usize MC = 20 * MR;
+  static constexpr usize NC = 256 * NR;
+};
+
+// c[mr, nr] = alpha * a[MR, kc] * b[kc, NR] + beta * c, with packed a and b;
+// c[i, j] is at `c + i * rs + j * cs`. beta == 0 does not read c.
+void gemm_kernel(usize kc, const f32* a, const f32* b, f32* c, usize rs, usize cs, usize mr, usize nr, f32 alpha,
+                 f32 beta);
+void gemm_kernel(usize kc, const f64* a, const f64* b, f64* c, usize rs, usize cs, usize mr, usize nr, f64 alpha,
+                 f64 beta);
+
+// rows [i0, i0 + mc), cols [p0, p0 + kc) of `a`, as MR-row panels zero padded to MR.
+template <class T>
+void gemm_pack_a(NdSlice<const T, 2> a, usize i0, usize mc, usize p0, usize kc, T* dst) {
+  constexpr auto MR = GemmBlocks<T>::MR;
+  const auto s0 = a._step[0];
+  const auto s1 = a._step[1];
+
+  for (usize ir = 0; ir < mc; ir += MR) {
+    const auto mr = cmp::min(MR, mc - ir);
+    for (usize p = 0; p < kc; ++p) {
+      const auto src = a._data + (p0 + p) * s0 + (i0 + ir) * s1;
+      for (usize r = 0; r < MR; ++r) {
+        dst[r] = r < mr ? src[r * s1] : T(0);
+      }
+      dst += MR;
+    }
+  }
+}
+
+// rows [p0, p0 + kc), cols [j0, j0 + nc) of `b`, as NR-col panels zero padded to NR.
+template <class T>
+void gemm_pack_b(NdSlice<const T, 2> b, usize p0, usize kc, usize j0, usize nc, T* dst) {
+  constexpr auto NR = GemmBlocks<T>::NR;
+  const auto s0 = b._step[0];
+  const auto s1 = b._step[1];
+
+  for (usize jr = 0; jr < nc; jr += NR) {
+    const auto nr = cmp::min(NR, nc - jr);
+    for (usize p = 0; p < kc; ++p) {
+      const auto src = b._data + (j0 + jr) * s0 + (p0 + p) * s1;
+      if (s0 == 1 && nr == NR) {
+        ptr::copy(src, dst, NR);
+      } else {
+        for (usize j = 0; j < NR; ++j) {
+          dst[j] = j < nr ? src[j * s0] : T(0);
+        }
+      }
+      dst += NR;
+    }
+  }
+}
+
+template <class T>
+void gemm_scale(NdSlice<T, 2> c, T beta) {
+  if (beta == T(0)) {
+    c.template assign<Assign>(T(0));
+  } else {
+    c.template assign<MulAssign>(beta);
+  }
+}
+
+}  // namespace imp
+
+// c = alpha * a * b + beta * c, where a is m x k, b is k x n and c is m x n.
+// dims are {cols, rows} like any NdSlice, so any step works, including
+// `transpose()` views. beta == 0 overwrites c without reading it.
+template <class T, class A, class B>
+void gemm(T alpha, const A& a, const B& b, T beta, NdSlice<T, 2> c, thread::Pool& pool = thread::Pool::global()) {
+  using Blocks = imp::GemmBlocks<T>;
+  constexpr auto MR = Blocks::MR;
+  constexpr auto NR = Blocks::NR;
+
+  const NdSlice<const T, 2> sa = tensor_t<A>{a};
+  const NdSlice<const T, 2> sb = tensor_t<B>{b};
+
+  const auto m = c._dims[1];
+  const auto n = c._dims[0];
+  const auto k = sa._dims[0];
+  sfc::assert_eq(sa._dims[1], m);
+  sfc::assert_eq(sb._dims[0], n);
+  sfc::assert_eq(sb._dims[1], k);
+
+  if (m == 0 || n == 0) {
+    return;
+  }
+  if (k == 0) {
+    imp::gemm_scale(c, beta);
+    return;
+  }
+
+  // small products stay on the calling thread.
+  const auto nthr = m * n * k < (usize(1) << 21) ? usize(1) : pool.num_threads() + 1;
+
+  auto bp = vec::RawVec<T>::with_capacity(Blocks::KC * cmp::min(Blocks::NC, (n + NR - 1) / NR * NR));
+  for (usize jc = 0; jc < n; jc += Blocks::NC) {
+    const auto nc = cmp::min(Blocks::NC, n - jc);
+    const auto np = (nc + NR - 1) / NR;
+
+    for (usize pc = 0; pc < k; pc += Blocks::KC) {
+      const auto kc = cmp::min(Blocks::KC, k - pc);
+      const auto beta_pc = pc == 0 ? beta : T(1);
+
+      imp::gemm_pack_b(sb, pc, kc, jc, nc, bp.ptr());
+
+      // split rows by MC, and also cols by NR panels when there are too few rows.
+      const auto nm = (m + Blocks::MC - 1) / Blocks::MC;
+      const auto nn = cmp::max(usize(1), cmp::min(np, nthr / nm));
+      const auto task = [&](usize t) {
+        const auto ic = (t / nn) * Blocks::MC;
+        const auto mc = cmp::min(Blocks::MC, m - ic);
+        const auto p0 = np * (t % nn) / nn;
+        const auto p1 = np * (t % nn + 1) / nn;
+
+        auto ap = vec::RawVec<T>::with_capacity(Blocks::MC * kc);
+        imp::gemm_pack_a(sa, ic, mc, pc, kc, ap.ptr());
+
+        for (auto jp = p0; jp < p1; ++jp) {
+          const auto jr = jp * NR;
+          const auto nr = cmp::min(NR, nc - jr);
+          for (usize ir = 0; ir < mc; ir += MR) {
+            const auto mr = cmp::min(MR, mc - ir);
+            const auto cp = c._data + (jc + jr) * c._step[0] + (ic + ir) * c._step[1];
+            imp::gemm_kernel(kc, ap.ptr() + ir * kc, bp.ptr() + jr * kc, cp, c._step[1], c._step[0], mr, nr, alpha,
+                             beta_pc);
+          }
+        }
+      };
+
+      if (nthr == 1) {
+        for (usize t = 0; t < nm * nn; ++t) {
+          task(t);
+        }
+      } else {
+        pool.for_each(nm * nn, task);
+      }
+    }
+  }
+}
+
+// a * b into a new array.
+template <class A, class B>
+auto matmul(const A& a, const B& b, thread::Pool& pool = thread::Pool::global()) {
+  using T = remove_const_t<typename tensor_t<A>::Item>;
+  const NdSlice<const T, 2> sa = tensor_t<A>{a};
+  const NdSlice<const T, 2> sb = tensor_t<B>{b};
+
+  auto c = NdArray<T, 2>::with_dims({sb._dims[0], sa._dims[1]});
+  math::gemm(T(1), sa, sb, T(0), *c, pool);
+  return c;
+}
+
+}  // namespace sfc::math
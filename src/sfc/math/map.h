@@ -28,6 +28,11 @@ struct Map<F(A)> {
       return Map<F(EA)>(_a[idx]);
     }
   }
+
+  template <class X = TA>
+  auto load(usize idx, usize cnt) const -> decltype(F{}(declval<const X&>().load(idx, cnt))) {
+    return F{}(_a.load(idx, cnt));
+  }
 };
 
 template <class F, class A, class B>
@@ -55,6 +60,12 @@ struct Map<F(A, B)> {
       return Map<F(EA, EB)>(_a[idx], _b[idx]);
     }
   }
+
+  template <class X = TA, class Y = TB>
+  auto load(usize idx, usize cnt) const
+      -> decltype(F{}(declval<const X&>().load(idx, cnt), declval<const Y&>().load(idx, cnt))) {
+    return F{}(_a.load(idx, cnt), _b.load(idx, cnt));
+  }
 };
 
 template <class A, class B>
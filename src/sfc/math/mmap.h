@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../fs.h"
+#include "adapters.h"
+#include "ndslice.h"
+
+namespace sfc::math {
+
+namespace imp {
+
+// the file starts with this header, padded to one page so that the items
+// are page aligned too.
+struct MmapHeader {
+  static constexpr usize SIZE = 4096;
+  static constexpr usize MAX_RANK = 8;
+  static constexpr u8 MAGIC[8] = {'s', 'f', 'c', '.', 'n', 'd', '\x01', 0};
+
+  u8 _magic[8];
+  u32 _dtype;
+  u32 _rank;
+  u64 _dims[MAX_RANK];
+  u64 _step[MAX_RANK];
+};
+
+// kind ('f', 'i' or 'u') in the high byte, item size in the low byte.
+template <class T>
+constexpr auto dtype_code() -> u32 {
+  static_assert(num::is_flt<T>() || num::is_int<T>());
+  const auto kind = num::is_flt<T>() ? u32('f') : num::is_sint<T>() ? u32('i') : u32('u');
+  return (kind << 8) | u32(sizeof(T));
+}
+
+}  // namespace imp
+
+// an array stored in a file: opening only maps it, and items are paged in
+// when first touched, so slicing a huge file reads just what is used.
+// `NdMmap<const T, N>` maps the file read-only.
+template <class T, usize N>
+struct NdMmap : NdSlice<T, N> {
+  using Base = NdSlice<T, N>;
+  using Header = imp::MmapHeader;
+  using typename Base::Dims;
+  using typename Base::Step;
+  using Base::_dims;
+  using Base::_step;
+
+  static constexpr bool WRITABLE = !__is_same(T, const remove_const_t<T>);
+  static_assert(N <= Header::MAX_RANK);
+
+  fs::Mmap _map;
+
+  // a new zero-filled file, replacing any existing one.
+  static auto create(Str path, Dims dims) -> NdMmap {
+    static_assert(WRITABLE);
+    const auto step = Step::from_dims(dims);
+    const auto size = Header::SIZE + dims.count() * sizeof(T);
+    auto map = fs::OpenOptions{}.read(true).write(true).create(true).truncate(true).mmap(path, size, 0);
+
+    auto& hdr = *(map.as_mut_ptr() % as<Header*>);
+    ptr::copy(Header::MAGIC, hdr._magic, sizeof(hdr._magic));
+    hdr._dtype = imp::dtype_code<remove_const_t<T>>();
+    hdr._rank = u32(N);
+    for (usize i = 0; i < N; ++i) {
+      hdr._dims[i] = dims[i];
+      hdr._step[i] = step[i];
+    }
+    return NdMmap::from_map(sfc::move(map));
+  }
+
+  // throws `io::Error::InvalidData` if the header does not match `T` and `N`,
+  // or describes more items than the file holds.
+  static auto open(Str path) -> NdMmap {
+    auto map = fs::OpenOptions{}.read(true).write(WRITABLE).mmap(path, 0, 0);
+    return NdMmap::from_map(sfc::move(map));
+  }
+
+  static auto from_map(fs::Mmap map) -> NdMmap {
+    if (map.len() < Header::SIZE) {
+      throw io::Error::InvalidData;
+    }
+
+    const auto& hdr = *(map.as_ptr() % as<const Header*>);
+    if (!ptr::eq(hdr._magic, Header::MAGIC, sizeof(hdr._magic)) ||
+        hdr._dtype != imp::dtype_code<remove_const_t<T>>() || hdr._rank != N) {
+      throw io::Error::InvalidData;
+    }
+
+    auto dims = Dims{};
+    auto step = Step{};
+    auto last = u64(0);
+    for (usize i = 0; i < N; ++i) {
+      dims._raw[i] = usize(hdr._dims[i]);
+      step._raw[i] = usize(hdr._step[i]);
+      last += hdr._dims[i] == 0 ? 0 : (hdr._dims[i] - 1) * hdr._step[i];
+    }
+    const auto cap = (map.len() - Header::SIZE) / sizeof(T);
+    if (dims.count() != 0 && last >= cap) {
+      throw io::Error::InvalidData;
+    }
+
+    const auto data = (map.as_mut_ptr() + Header::SIZE) % as<T*>;
+    return NdMmap{Base{data, dims, step}, sfc::move(map)};
+  }
+
+  auto operator*() const -> NdSlice<const T, N> {
+    return *this;
+  }
+
+  auto operator*() -> Base {
+    return *this;
+  }
+
+  void operator<<=(const auto& u) {
+    this->template assign<math::Assign>(u);
+  }
+
+  // blocks until the items written so far are on disk; without it they
+  // still reach the file, at the latest when the last mapping goes away.
+  void flush() {
+    _map.flush();
+  }
+};
+
+}  // namespace sfc::math
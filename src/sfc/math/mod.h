@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../core.h"
+#include "simd.h"
 
 namespace sfc::math {
 
@@ -38,6 +39,12 @@ template <auto N>
 using idx_seq_t = XIdxs<usize, __integer_pack(N)...>;
 #endif
 
+template <usize... I>
+auto rev_idxs(Idxs<I...>) -> Idxs<(sizeof...(I) - 1 - I)...>;
+
+template <usize N>
+using rev_seq_t = decltype(imp::rev_idxs(idx_seq_t<N>{}));
+
 template <usize I, class... T>
 using type_t = __type_pack_element<I, T...>;
 
@@ -63,11 +70,11 @@ struct Dims {
   }
 
   auto operator==(const Dims& other) const -> bool {
-    return ptr::eq(_raw, other._raw, imp::idx_seq_t<RANK>());
+    return ptr::eq(_raw, other._raw, RANK);
   }
 
   auto operator!=(const Dims& other) const -> bool {
-    return ptr::ne(_raw, other._raw, imp::idx_seq_t<RANK>());
+    return ptr::ne(_raw, other._raw, RANK);
   }
 
   void format(fmt::Formatter& f) const {
@@ -175,6 +182,11 @@ struct Scalar {
   auto operator[](usize) const {
     return _val;
   }
+
+  template <class U = T, class V = simd::vec_t<U>>
+  auto load(usize, usize) const -> V {
+    return simd::splat(_val);
+  }
 };
 
 template <class T, usize N>
@@ -1,14 +1,79 @@
 #pragma once
 
+#include "../alloc.h"
 #include "adapters.h"
 #include "ndslice.h"
 
 namespace sfc::math {
 
+namespace imp {
+
+// fixed-size storage starting on a cache line.
+template <class T>
+struct NdBuf {
+  static constexpr usize ALIGN = 64;
+
+  ptr::Unique<T> _ptr;
+  usize _len;
+
+  explicit NdBuf(ptr::Unique<T> ptr, usize len) : _ptr{sfc::move(ptr)}, _len{len} {}
+
+  NdBuf(NdBuf&&) noexcept = default;
+
+  ~NdBuf() {
+    if (_ptr.is_null()) return;
+    alloc::GLOBAL.dealloc(_ptr._0, NdBuf::layout(_len));
+  }
+
+  static auto layout(usize len) -> alloc::Layout {
+    const auto align = cmp::max(ALIGN, alignof(T));
+    return alloc::Layout::from_size_align(num::align_up(len * sizeof(T), align), align);
+  }
+
+  static auto with_len(usize len) -> NdBuf {
+    const auto p = alloc::GLOBAL.alloc(NdBuf::layout(len));
+    return NdBuf{static_cast<T*>(p), len};
+  }
+
+  auto ptr() const -> T* {
+    return _ptr._0;
+  }
+
+  auto len() const -> usize {
+    return _len;
+  }
+};
+
+// rows (runs along dims[0]) padded to whole cache lines, plus one more line
+// when a row would be a multiple of 4K, so that walking down a column does
+// not hit the same cache set (and 4K alias loads with stores) on every row.
+template <class T, usize N>
+auto padded_step(Dims<N> dims) -> Step<N> {
+  constexpr auto LINE = NdBuf<T>::ALIGN / sizeof(T);
+  if constexpr (N == 1 || NdBuf<T>::ALIGN % sizeof(T) != 0) {
+    return Step<N>::from_dims(dims);
+  } else {
+    auto row = num::align_up(dims[0], LINE);
+    if (dims[1] > 1 && row * sizeof(T) % 4096 == 0) {
+      row += LINE;
+    }
+
+    auto step = Step<N>{};
+    step._raw[0] = 1;
+    step._raw[1] = row;
+    for (usize i = 2; i < N; ++i) {
+      step._raw[i] = step._raw[i - 1] * dims[i - 1];
+    }
+    return step;
+  }
+}
+
+}  // namespace imp
+
 template <class T, usize N>
 struct NdArray: NdSlice<T, N> {
   using Base = NdSlice<T, N>;
-  using Data = vec::RawVec<T>;
+  using Data = imp::NdBuf<T>;
   using typename Base::Dims;
   using typename Base::Step;
   using Base::_dims;
@@ -16,12 +81,41 @@ struct NdArray: NdSlice<T, N> {
 
   Data _data;
 
+  // dense items, the first one on a cache line.
   static auto with_dims(Dims dims) -> NdArray {
-    auto data = Data::with_capacity(dims.count());
-    auto base = Base{data.ptr(), dims, Step::from_dims(dims)};
+    return NdArray::with_dims_step(dims, Step::from_dims(dims));
+  }
+
+  // every row starts on a cache line; `is_array()` is false unless dims[0]
+  // needs no padding.
+  static auto with_dims_padded(Dims dims) -> NdArray {
+    return NdArray::with_dims_step(dims, imp::padded_step<T>(dims));
+  }
+
+  // room for the farthest item, whatever order the steps come in; padded
+  // steps also keep the tail of their last row.
+  static auto with_dims_step(Dims dims, Step step) -> NdArray {
+    auto len = usize(1);
+    for (usize i = 0; i < N; ++i) {
+      if (dims[i] == 0) {
+        len = 0;
+        break;
+      }
+      len += (dims[i] - 1) * step[i];
+    }
+    if (len != 0) {
+      len = cmp::max(len, dims[N - 1] * step[N - 1]);
+    }
+    auto data = Data::with_len(len);
+    auto base = Base{data.ptr(), dims, step};
     return NdArray{base, sfc::move(data)};
   }
 
+  // items in storage, padding included.
+  auto span() const -> usize {
+    return _data.len();
+  }
+
   auto operator*() const -> Base {
     return *this;
   }
@@ -33,12 +127,20 @@ struct NdArray: NdSlice<T, N> {
   void operator<<(Base src) {
     sfc::assert_eq(this->_dims, src._dims);
     sfc::assert_eq(this->_step, src._step);
+    if (!this->is_array()) {
+      this->template assign<math::Assign>(src);
+      return;
+    }
     ptr::copy(src.as_ptr(), this->as_mut_ptr(), this->count());
   }
 
   void operator>>(Base dst) const {
     sfc::assert_eq(this->_dims, dst._dims);
     sfc::assert_eq(this->_step, dst._step);
+    if (!this->is_array()) {
+      dst.template assign<math::Assign>(**this);
+      return;
+    }
     ptr::copy(this->as_ptr(), dst.as_mut_ptr(), this->count());
   }
 
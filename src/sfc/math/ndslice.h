@@ -124,6 +124,15 @@ struct NdSlice {
     return {data, dims | I{}, _step | I{}};
   }
 
+  // reversed dims, a matrix transpose for rank 2; no item is moved.
+  auto transpose() const -> NdSlice<const T, RANK> {
+    return {_data, _dims | imp::rev_seq_t<RANK>{}, _step | imp::rev_seq_t<RANK>{}};
+  }
+
+  auto transpose() -> NdSlice {
+    return {_data, _dims | imp::rev_seq_t<RANK>{}, _step | imp::rev_seq_t<RANK>{}};
+  }
+
   template <class F, class U>
   void assign(const U& u) {
     auto dst = *this;
@@ -238,6 +247,12 @@ struct NdSlice<T, 1> {
     return {data, dims, _step};
   }
 
+  // packet of `cnt` items from `idx`, see simd::load
+  template <class U = T, class V = simd::vec_t<remove_const_t<U>>>
+  auto load(usize idx, usize cnt) const -> V {
+    return simd::load<remove_const_t<T>>(_data + idx * _step[0], _step[0], cnt);
+  }
+
   void format(fmt::Formatter& f) const {
     f._depth += 1;
     for (usize i = 0; i < _dims[0]; i += 1) {
@@ -249,10 +264,18 @@ struct NdSlice<T, 1> {
 
   template <class F, class U>
   void assign(const U& u) {
-    auto dst = *this;
-    auto src = tensor_t<U>{u};
-    for (usize i = 0; i < _dims[0]; i += 1) {
-      F{}(dst[i], src[i]);
+    this->template assign_range<F>(tensor_t<U>{u}, 0, _dims[0]);
+  }
+
+  template <class F, class X>
+  void assign_range(const X& src, usize i0, usize i1) {
+    if constexpr (simd::can_assign<F, T, X>) {
+      simd::assign<F>(_data, _step[0], i0, i1, src);
+    } else {
+      auto dst = *this;
+      for (usize i = i0; i < i1; i += 1) {
+        F{}(dst[i], src[i]);
+      }
     }
   }
 };
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../thread/job.h"
+#include "ndslice.h"
+#include "reduce.h"
+
+namespace sfc::math::par {
+
+// fewer items than this per task are not worth waking a thread for.
+static constexpr usize MIN_ITEMS = 1u << 15;
+
+inline auto num_tasks(thread::Pool& pool, usize items) -> usize {
+  return cmp::min(pool.num_threads() + 1, items / MIN_ITEMS);
+}
+
+// [i0, i1) of the k-th of n chunks, cut on 64-item boundaries so that
+// neighbouring tasks do not write the same cache line.
+inline auto chunk(usize len, usize k, usize n) -> iter::Range<usize> {
+  const auto i0 = k == 0 ? 0u : (len * k / n) & ~usize(63);
+  const auto i1 = k + 1 == n ? len : (len * (k + 1) / n) & ~usize(63);
+  return {i0, i1};
+}
+
+// splits the outermost dim across `pool`; a rank-1 dst is split by range.
+template <class F, class T, usize N, class U>
+void assign(NdSlice<T, N> dst, const U& u, thread::Pool& pool = thread::Pool::global()) {
+  auto src = tensor_t<U>{u};
+
+  const auto ntask = par::num_tasks(pool, dst.count());
+  if (ntask <= 1) {
+    dst.template assign<F>(src);
+    return;
+  }
+
+  const auto len = dst.len();
+  if constexpr (N == 1) {
+    pool.for_each(ntask, [&](usize k) {
+      const auto r = par::chunk(len, k, ntask);
+      dst.template assign_range<F>(src, r.start, r.end);
+    });
+  } else if (len < ntask) {
+    for (usize i = 0; i < len; ++i) {
+      par::assign<F>(dst[i], src[i], pool);
+    }
+  } else {
+    pool.for_each(ntask, [&](usize k) {
+      for (usize i = len * k / ntask; i < len * (k + 1) / ntask; ++i) {
+        dst[i].template assign<F>(src[i]);
+      }
+    });
+  }
+}
+
+// folds every item of `u`. the partial result of each task is combined
+// pairwise in a fixed tree, so the result does not depend on thread timing.
+template <class F, class U>
+auto reduce(const U& u, thread::Pool& pool = thread::Pool::global()) {
+  using X = tensor_t<U>;
+  auto src = X{u};
+
+  const auto len = src.len();
+  auto ntask = usize(1);
+  if constexpr (X::rank() == 1) {
+    ntask = par::num_tasks(pool, len);
+  } else {
+    ntask = cmp::min(par::num_tasks(pool, len * tensor_t<decltype(src[0])>{src[0]}.len()), len);
+  }
+  if (ntask <= 1) {
+    return math::fold_all<F>(src);
+  }
+
+  using S = decltype(math::fold_all<F>(src));
+  auto parts = vec::RawVec<S>::with_capacity(ntask);
+  pool.for_each(ntask, [&](usize k) {
+    if constexpr (X::rank() == 1) {
+      const auto r = par::chunk(len, k, ntask);
+      ptr::write(parts.ptr() + k, math::fold<F>(src, r.start, r.end));
+    } else {
+      using E = tensor_t<decltype(src[0])>;
+      const auto i0 = len * k / ntask;
+      const auto i1 = len * (k + 1) / ntask;
+      auto s = math::fold_all<F>(E{src[i0]});
+      for (auto i = i0 + 1; i < i1; ++i) {
+        s = F{}(s, math::fold_all<F>(E{src[i]}));
+      }
+      ptr::write(parts.ptr() + k, s);
+    }
+  });
+
+  for (usize w = 1; w < ntask; w *= 2) {
+    for (usize k = 0; k + w < ntask; k += 2 * w) {
+      parts[k] = F{}(parts[k], parts[k + w]);
+    }
+  }
+  return parts[0];
+}
+
+}  // namespace sfc::math::par
@@ -1,9 +1,498 @@
 #pragma once
 
-#include "mod.h"
+#include "ndarray.h"
 
 namespace sfc::math {
 
+// items [i0, i1) of a rank-1 tensor, i0 < i1.
+template <class F, class X>
+auto fold(const X& src, usize i0, usize i1) {
+  if constexpr (simd::can_fold<F, X>) {
+    return simd::fold<F>(src, i0, i1);
+  } else {
+    auto s = src[i0];
+    for (auto i = i0 + 1; i < i1; ++i) {
+      s = F{}(s, src[i]);
+    }
+    return s;
+  }
+}
+
+// every item of a tensor.
+template <class F, class X>
+auto fold_all(const X& src) {
+  if constexpr (X::rank() == 1) {
+    return math::fold<F>(src, 0, src.len());
+  } else {
+    using E = tensor_t<decltype(src[0])>;
+    auto s = math::fold_all<F>(E{src[0]});
+    for (usize i = 1; i < src.len(); ++i) {
+      s = F{}(s, math::fold_all<F>(E{src[i]}));
+    }
+    return s;
+  }
+}
+
+// `y = F(y, x)`, an accumulating assignment for `NdSlice::assign`.
+template <class F>
+struct Fold {
+  template <class Y, class X>
+  auto operator()(Y& y, X x) const -> decltype(void(y = F{}(y, x))) {
+    y = F{}(y, x);
+  }
+};
+
+template <class T>
+struct Summary;
+
+namespace imp {
+
+// the same items, with `axis` moved to the outermost dim.
+template <class T, usize N>
+auto axis_last(NdSlice<T, N> s, usize axis) -> NdSlice<T, N> {
+  sfc::assert(axis < N, "math: axis out of range");
+  auto res = s;
+  for (auto i = axis; i + 1 < N; ++i) {
+    res._dims._raw[i] = s._dims._raw[i + 1];
+    res._step._raw[i] = s._step._raw[i + 1];
+  }
+  res._dims._raw[N - 1] = s._dims._raw[axis];
+  res._step._raw[N - 1] = s._step._raw[axis];
+  return res;
+}
+
+template <usize N>
+auto dims_without(Dims<N> dims, usize axis) -> Dims<N - 1> {
+  sfc::assert(axis < N, "math: axis out of range");
+  auto res = Dims<N - 1>{};
+  for (usize i = 0, j = 0; i < N; ++i) {
+    if (i != axis) {
+      res._raw[j++] = dims._raw[i];
+    }
+  }
+  return res;
+}
+
+// partial sums of equal-sized blocks are added together first, like a
+// binary counter, so the rounding error grows with log(n) instead of n.
+template <class T>
+struct Pairwise {
+  T _val[64] = {};
+  usize _cnt = 0;
+
+  void push(T x) {
+    auto k = usize(0);
+    for (; (_cnt >> k) & 1; ++k) {
+      x = _val[k] + x;
+    }
+    _val[k] = x;
+    _cnt += 1;
+  }
+
+  auto sum() const -> T {
+    auto s = T(0);
+    for (usize k = 0; k < 64; ++k) {
+      if ((_cnt >> k) & 1) {
+        s += _val[k];
+      }
+    }
+    return s;
+  }
+};
+
+template <class T>
+inline void kahan_add(T& s, T& c, T x) {
+  const auto y = x - c;
+  const auto t = s + y;
+  c = (t - s) - y;
+  s = t;
+}
+
+template <class F, class T, usize N>
+void reduce_axis(NdSlice<const T, N> src, usize axis, NdSlice<T, N - 1> dst) {
+  static_assert(N >= 2);
+
+  // the innermost axis is contiguous: fold each row.
+  if (axis == 0) {
+    for (usize i = 0; i < src.len(); ++i) {
+      if constexpr (N == 2) {
+        const auto row = src[i];
+        dst[i] = math::fold<F>(row, 0, row.len());
+      } else {
+        imp::reduce_axis<F>(src[i], 0, dst[i]);
+      }
+    }
+    return;
+  }
+
+  // otherwise accumulate whole sub-arrays, so that the inner loop stays contiguous.
+  const auto v = imp::axis_last(src, axis);
+  sfc::assert_eq(dst._dims, v[0]._dims);
+  dst.template assign<Assign>(v[0]);
+  for (usize i = 1; i < v.len(); ++i) {
+    dst.template assign<Fold<F>>(v[i]);
+  }
+}
+
+template <class X>
+auto summarize(const X& src, usize i0, usize i1);
+
+struct SummaryInit {
+  template <class Y, class X>
+  void operator()(Y& y, X x) const {
+    y = Y{};
+    y.push(x);
+  }
+};
+
+struct SummaryPush {
+  template <class Y, class X>
+  void operator()(Y& y, X x) const {
+    y.push(x);
+  }
+};
+
+template <class T, usize N>
+void summarize_axis(NdSlice<const T, N> src, usize axis, NdSlice<Summary<T>, N - 1> dst) {
+  static_assert(N >= 2);
+
+  if (axis == 0) {
+    for (usize i = 0; i < src.len(); ++i) {
+      if constexpr (N == 2) {
+        const auto row = src[i];
+        dst[i] = imp::summarize(row, 0, row.len());
+      } else {
+        imp::summarize_axis(src[i], 0, dst[i]);
+      }
+    }
+    return;
+  }
+
+  const auto v = imp::axis_last(src, axis);
+  sfc::assert_eq(dst._dims, v[0]._dims);
+  dst.template assign<SummaryInit>(v[0]);
+  for (usize i = 1; i < v.len(); ++i) {
+    dst.template assign<SummaryPush>(v[i]);
+  }
+}
+
+}  // namespace imp
+
+// reduces `a` along `axis` into `dst`, whose dims are those of `a` without `axis`.
+template <class F, class A, class T, usize N>
+void reduce_axis(const A& a, usize axis, NdSlice<T, N> dst) {
+  const NdSlice<const T, N + 1> src = tensor_t<A>{a};
+  imp::reduce_axis<F>(src, axis, dst);
+}
+
+template <class F, class A>
+auto reduce_axis(const A& a, usize axis) {
+  using S = tensor_t<A>;
+  using T = remove_const_t<typename S::Item>;
+  const NdSlice<const T, S::RANK> src = S{a};
+
+  auto res = NdArray<T, S::RANK - 1>::with_dims(imp::dims_without(src._dims, axis));
+  imp::reduce_axis<F>(src, axis, *res);
+  return res;
+}
+
+// sum of a rank-1 tensor, added pairwise by blocks.
+template <class X>
+auto pairwise_sum(const X& src) {
+  using T = remove_const_t<remove_ref_t<decltype(src[0])>>;
+  const auto n = src.len();
+
+  auto acc = imp::Pairwise<T>{};
+  auto i = usize(0);
+  if constexpr (simd::can_load<X>) {
+    constexpr auto L = simd::lanes<T>;
+    while (i + L <= n) {
+      const auto end = cmp::min(n, i + 64 * L);
+      auto s = simd::vec_t<T>{};
+      for (; i + L <= end; i += L) {
+        s += src.load(i, L);
+      }
+      acc.push(simd::hsum(s));
+    }
+  }
+  while (i < n) {
+    const auto end = cmp::min(n, i + 128);
+    auto s = T(0);
+    for (; i < end; ++i) {
+      s += src[i];
+    }
+    acc.push(s);
+  }
+  return acc.sum();
+}
+
+// sum of a rank-1 tensor, with Kahan compensation in every lane.
+template <class X>
+auto kahan_sum(const X& src) {
+  using T = remove_const_t<remove_ref_t<decltype(src[0])>>;
+  const auto n = src.len();
+
+  auto s = T(0);
+  auto c = T(0);
+  auto i = usize(0);
+  if constexpr (simd::can_load<X>) {
+    using V = simd::vec_t<T>;
+    constexpr auto L = simd::lanes<T>;
+    if (n >= L) {
+      auto vs = V{};
+      auto vc = V{};
+      for (; i + L <= n; i += L) {
+        const auto y = src.load(i, L) - vc;
+        const auto t = vs + y;
+        vc = (t - vs) - y;
+        vs = t;
+      }
+      for (usize k = 0; k < L; ++k) {
+        imp::kahan_add(s, c, vs[k]);
+        imp::kahan_add(s, c, -vc[k]);
+      }
+    }
+  }
+  for (; i < n; ++i) {
+    imp::kahan_add(s, c, src[i]);
+  }
+  return s;
+}
+
+// count, sum, sum of squares, min and max (with their first index) in one pass.
+template <class T>
+struct Summary {
+  static_assert(num::is_flt<T>());
+
+  usize _count = 0;
+  T _shift = 0;  // the first item: the sums are of `x - _shift`, which keeps var() accurate far from 0
+  T _sum = 0;
+  T _sumsq = 0;
+  T _min = 0;
+  T _max = 0;
+  usize _argmin = 0;
+  usize _argmax = 0;
+
+  auto count() const -> usize {
+    return _count;
+  }
+
+  auto sum() const -> T {
+    return _sum + T(_count) * _shift;
+  }
+
+  auto mean() const -> T {
+    return _count == 0 ? T(0) : _shift + _sum / T(_count);
+  }
+
+  // population variance
+  auto var() const -> T {
+    if (_count == 0) {
+      return T(0);
+    }
+    const auto n = T(_count);
+    return cmp::max(T(0), (_sumsq - _sum * _sum / n) / n);
+  }
+
+  auto std() const -> T {
+    if constexpr (__is_same(T, f32)) {
+      return __builtin_sqrtf(this->var());
+    } else {
+      return __builtin_sqrt(this->var());
+    }
+  }
+
+  auto min() const -> T {
+    return _min;
+  }
+
+  auto max() const -> T {
+    return _max;
+  }
+
+  auto argmin() const -> usize {
+    return _argmin;
+  }
+
+  auto argmax() const -> usize {
+    return _argmax;
+  }
+
+  void push(T x) {
+    if (_count == 0) {
+      _shift = _min = _max = x;
+    }
+    const auto d = x - _shift;
+    _sum += d;
+    _sumsq += d * d;
+    if (x < _min) {
+      _min = x;
+      _argmin = _count;
+    }
+    if (x > _max) {
+      _max = x;
+      _argmax = _count;
+    }
+    _count += 1;
+  }
+
+  // `other` summarizes the items right after those of `*this`.
+  void merge(const Summary& other) {
+    if (other._count == 0) {
+      return;
+    }
+    if (_count == 0) {
+      *this = other;
+      return;
+    }
+
+    const auto k = other._shift - _shift;
+    const auto m = T(other._count);
+    _sumsq += other._sumsq + 2 * k * other._sum + m * k * k;
+    _sum += other._sum + m * k;
+    if (other._min < _min) {
+      _min = other._min;
+      _argmin = _count + other._argmin;
+    }
+    if (other._max > _max) {
+      _max = other._max;
+      _argmax = _count + other._argmax;
+    }
+    _count += other._count;
+  }
+};
+
+namespace imp {
+
+template <class X>
+auto summarize(const X& src, usize i0, usize i1) {
+  using T = remove_const_t<remove_ref_t<decltype(src[0])>>;
+
+  auto res = Summary<T>{};
+  if (i0 == i1) {
+    return res;
+  }
+  res._shift = res._min = res._max = src[i0];
+
+  auto sums = imp::Pairwise<T>{};
+  auto sqs = imp::Pairwise<T>{};
+  auto i = i0;
+  if constexpr (simd::can_load<X>) {
+    using V = simd::vec_t<T>;
+    using I = decltype(V{} < V{});
+    using E = remove_ref_t<decltype(declval<I&>()[0])>;
+    constexpr auto L = simd::lanes<T>;
+
+    if (i0 + L <= i1) {
+      const auto k = simd::splat(res._shift);
+      auto idx = I{};
+      for (usize l = 0; l < L; ++l) {
+        idx[l] = E(l);
+      }
+
+      auto vmin = src.load(i0, L);
+      auto vmax = vmin;
+      auto imin = idx;
+      auto imax = idx;
+      while (i + L <= i1) {
+        const auto end = cmp::min(i1, i + 64 * L);
+        auto s = V{};
+        auto ss = V{};
+        for (; i + L <= end; i += L) {
+          const auto x = src.load(i, L);
+          const auto d = x - k;
+          s += d;
+          ss += d * d;
+
+          const auto at = idx + E(i - i0);
+          const auto lt = x < vmin;
+          vmin = simd::select(lt, x, vmin);
+          imin = simd::select(lt, at, imin);
+          const auto gt = x > vmax;
+          vmax = simd::select(gt, x, vmax);
+          imax = simd::select(gt, at, imax);
+        }
+        sums.push(simd::hsum(s));
+        sqs.push(simd::hsum(ss));
+      }
+
+      // across lanes, the first index wins a tie.
+      res._min = vmin[0];
+      res._max = vmax[0];
+      res._argmin = usize(imin[0]);
+      res._argmax = usize(imax[0]);
+      for (usize l = 1; l < L; ++l) {
+        if (vmin[l] < res._min || (vmin[l] == res._min && usize(imin[l]) < res._argmin)) {
+          res._min = vmin[l];
+          res._argmin = usize(imin[l]);
+        }
+        if (vmax[l] > res._max || (vmax[l] == res._max && usize(imax[l]) < res._argmax)) {
+          res._max = vmax[l];
+          res._argmax = usize(imax[l]);
+        }
+      }
+    }
+  }
+
+  auto s = T(0);
+  auto ss = T(0);
+  for (; i < i1; ++i) {
+    const auto x = src[i];
+    const auto d = x - res._shift;
+    s += d;
+    ss += d * d;
+    if (x < res._min) {
+      res._min = x;
+      res._argmin = i - i0;
+    }
+    if (x > res._max) {
+      res._max = x;
+      res._argmax = i - i0;
+    }
+  }
+  sums.push(s);
+  sqs.push(ss);
+
+  res._count = i1 - i0;
+  res._sum = sums.sum();
+  res._sumsq = sqs.sum();
+  return res;
+}
+
+}  // namespace imp
+
+// one pass over a rank-1 tensor.
+template <class X>
+auto summarize(const X& src) {
+  // packets count items with 32-bit lanes for f32: keep each run below that.
+  constexpr auto RUN = usize(1) << 30;
+
+  const auto n = src.len();
+  auto res = imp::summarize(src, 0, cmp::min(n, RUN));
+  for (auto i0 = RUN; i0 < n; i0 += RUN) {
+    res.merge(imp::summarize(src, i0, cmp::min(n, i0 + RUN)));
+  }
+  return res;
+}
+
+// one Summary for every position of `a` without `axis`, in one pass over `a`.
+template <class A, class T, usize N>
+void summarize_axis(const A& a, usize axis, NdSlice<Summary<T>, N> dst) {
+  const NdSlice<const T, N + 1> src = tensor_t<A>{a};
+  imp::summarize_axis(src, axis, dst);
+}
+
+template <class A>
+auto summarize_axis(const A& a, usize axis) {
+  using S = tensor_t<A>;
+  using T = remove_const_t<typename S::Item>;
+  const NdSlice<const T, S::RANK> src = S{a};
+
+  auto res = NdArray<Summary<T>, S::RANK - 1>::with_dims(imp::dims_without(src._dims, axis));
+  imp::summarize_axis(src, axis, *res);
+  return res;
+}
+
 template <class X>
 struct Reduce;
 
@@ -18,7 +507,7 @@ struct Reduce<F(A)> {
   }
 
   auto len() const noexcept -> usize {
-    return _a[0].len();
+    return _a.len();
   }
 
   auto operator[](usize idx) const noexcept {
@@ -27,12 +516,7 @@ struct Reduce<F(A)> {
 
     if constexpr (rank() == 1) {
       auto v = tensor_t<E>{e};
-      auto n = v.len();
-      auto s = v[0];
-      for (auto i : ops::Range{1u, n}) {
-        s = F{}(e, v[i]);
-      }
-      return s;
+      return math::fold<F>(v, 0, v.len());
     } else {
       return Reduce<F(E)>{e};
     }
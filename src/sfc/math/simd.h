@@ -0,0 +1,312 @@
+#pragma once
+
+#include "../core.h"
+
+namespace sfc::math::simd {
+
+// packets are 64 bytes wide: 16 lanes of f32, 8 lanes of f64.
+static constexpr usize BYTES = 64;
+
+template <class T, class = void>
+struct Packet {};
+
+template <class T>
+struct Packet<T, when_t<num::is_int<T>() || __is_same(T, f32) || __is_same(T, f64)>> {
+  typedef T Type __attribute__((vector_size(BYTES)));
+  static constexpr usize LANES = BYTES / sizeof(T);
+};
+
+template <class T>
+using vec_t = typename Packet<T>::Type;
+
+template <class T>
+static constexpr usize lanes = Packet<T>::LANES;
+
+// lanes in [cnt, LANES) repeat the last valid element, so a partial packet never
+// feeds garbage (zero divisors, log(0), ...) into the kernels.
+template <class T>
+inline auto load(const T* p, usize step, usize cnt) -> vec_t<T> {
+  auto v = vec_t<T>{};
+  if (step == 1 && cnt == lanes<T>) {
+    __builtin_memcpy(&v, p, sizeof(v));
+    return v;
+  }
+  for (usize i = 0; i < lanes<T>; ++i) {
+    v[i] = p[(i < cnt ? i : cnt - 1) * step];
+  }
+  return v;
+}
+
+template <class T>
+inline void store(T* p, usize step, usize cnt, const vec_t<T>& v) {
+  if (step == 1 && cnt == lanes<T>) {
+    __builtin_memcpy(p, &v, sizeof(v));
+    return;
+  }
+  for (usize i = 0; i < cnt; ++i) {
+    p[i * step] = v[i];
+  }
+}
+
+template <class T>
+inline auto splat(T val) -> vec_t<T> {
+  return vec_t<T>{} + val;
+}
+
+template <class T>
+inline auto iota() -> vec_t<T> {
+  auto v = vec_t<T>{};
+  for (usize i = 0; i < lanes<T>; ++i) {
+    v[i] = T(i);
+  }
+  return v;
+}
+
+template <class V, class M>
+inline auto select(M m, V a, V b) -> V {
+  const auto x = __builtin_bit_cast(M, a);
+  const auto y = __builtin_bit_cast(M, b);
+  return __builtin_bit_cast(V, (x & m) | (y & ~m));
+}
+
+// sum of the lanes, pairwise.
+template <class V>
+inline auto hsum(V v) {
+  for (auto w = sizeof(V) / sizeof(v[0]) / 2; w != 0; w /= 2) {
+    for (usize i = 0; i < w; ++i) {
+      v[i] += v[i + w];
+    }
+  }
+  return v[0];
+}
+
+#pragma region f32 kernels
+using f32x = vec_t<f32>;
+using i32x = vec_t<i32>;
+
+inline auto floor(f32x x) -> f32x {
+  const auto t = __builtin_convertvector(__builtin_convertvector(x, i32x), f32x);
+  return t - __builtin_bit_cast(f32x, (t > x) & __builtin_bit_cast(i32x, splat(1.0f)));
+}
+
+inline auto exp(f32x x) -> f32x {
+  x = select(x > 88.3762626647949f, splat(88.3762626647949f), x);
+  x = select(x < -87.3365447504019f, splat(-87.3365447504019f), x);
+
+  const auto n = floor(x * 1.44269504088896341f + 0.5f);
+  x = x - n * 0.693359375f + n * 2.12194440e-4f;
+
+  const auto z = x * x;
+  auto y = 1.9875691500E-4f * x + 1.3981999507E-3f;
+  y = y * x + 8.3334519073E-3f;
+  y = y * x + 4.1665795894E-2f;
+  y = y * x + 1.6666665459E-1f;
+  y = y * x + 5.0000001201E-1f;
+  y = y * z + x + 1.0f;
+
+  const auto e = (__builtin_convertvector(n, i32x) + 127) << 23;
+  return y * __builtin_bit_cast(f32x, e);
+}
+
+inline auto log(f32x x) -> f32x {
+  const auto invalid = ~(x >= 0.0f);
+  const auto zero = x == 0.0f;
+  const auto inf = x == __builtin_inff();
+  x = select(x < 1.17549435e-38f, splat(1.17549435e-38f), x);
+
+  auto bits = __builtin_bit_cast(i32x, x);
+  auto e = __builtin_convertvector((bits >> 23) - 126, f32x);
+  bits = (bits & ~0x7f800000) | 0x3f000000;
+  x = __builtin_bit_cast(f32x, bits);
+
+  // x in [0.5, 1): fold to [sqrt(1/2), sqrt(2)) around 1.
+  const auto small = x < 0.707106781186547524f;
+  e = e - __builtin_bit_cast(f32x, small & __builtin_bit_cast(i32x, splat(1.0f)));
+  x = x - 1.0f + __builtin_bit_cast(f32x, small & __builtin_bit_cast(i32x, x));
+
+  const auto z = x * x;
+  auto y = 7.0376836292E-2f * x - 1.1514610310E-1f;
+  y = y * x + 1.1676998740E-1f;
+  y = y * x - 1.2420140846E-1f;
+  y = y * x + 1.4249322787E-1f;
+  y = y * x - 1.6668057665E-1f;
+  y = y * x + 2.0000714765E-1f;
+  y = y * x - 2.4999993993E-1f;
+  y = y * x + 3.3333331174E-1f;
+  y = y * x * z;
+
+  y = y - e * 2.12194440e-4f - 0.5f * z;
+  x = x + y + e * 0.693359375f;
+
+  x = select(zero, splat(-__builtin_inff()), x);
+  x = select(inf, splat(__builtin_inff()), x);
+  return select(invalid, splat(__builtin_nanf("")), x);
+}
+
+// cos_sel: 0 for sin, 2 for cos (a quarter turn of octants).
+inline auto sin_cos(f32x x, i32 cos_sel) -> f32x {
+  auto sign = __builtin_bit_cast(i32x, x) & i32(0x80000000);
+  if (cos_sel != 0) {
+    sign = i32x{};
+  }
+  x = __builtin_bit_cast(f32x, __builtin_bit_cast(i32x, x) & 0x7fffffff);
+
+  auto j = __builtin_convertvector(x * 1.27323954473516f, i32x);
+  j = (j + 1) & ~1;
+  const auto y = __builtin_convertvector(j, f32x);
+  j = j + cos_sel;
+
+  sign = sign ^ ((j & 4) << 29);
+  const auto use_cos = (j & 2) != 0;
+
+  x = x - y * 0.78515625f - y * 2.4187564849853515625e-4f - y * 3.77489497744594108e-8f;
+
+  const auto z = x * x;
+  auto c = 2.443315711809948E-005f * z - 1.388731625493765E-003f;
+  c = c * z + 4.166664568298827E-002f;
+  c = c * z * z - 0.5f * z + 1.0f;
+
+  auto s = -1.9515295891E-4f * z + 8.3321608736E-3f;
+  s = s * z - 1.6666654611E-1f;
+  s = s * z * x + x;
+
+  const auto r = select(use_cos, c, s);
+  return __builtin_bit_cast(f32x, __builtin_bit_cast(i32x, r) ^ sign);
+}
+
+inline auto sin(f32x x) -> f32x {
+  return sin_cos(x, 0);
+}
+
+inline auto cos(f32x x) -> f32x {
+  return sin_cos(x, 2);
+}
+
+inline auto tanh(f32x x) -> f32x {
+  const auto sign = __builtin_bit_cast(i32x, x) & i32(0x80000000);
+  const auto a = __builtin_bit_cast(f32x, __builtin_bit_cast(i32x, x) & 0x7fffffff);
+
+  // |x| >= 0.625: 1 - 2 / (exp(2|x|) + 1)
+  const auto big = 1.0f - 2.0f / (simd::exp(a + a) + 1.0f);
+  const auto big_s = __builtin_bit_cast(f32x, __builtin_bit_cast(i32x, big) ^ sign);
+
+  const auto z = x * x;
+  auto y = -5.70498872745E-3f * z + 2.06390887954E-2f;
+  y = y * z - 5.37397155531E-2f;
+  y = y * z + 1.33314422036E-1f;
+  y = y * z - 3.33332819422E-1f;
+  y = y * z * x + x;
+
+  return select(a < 0.625f, y, big_s);
+}
+#pragma endregion
+
+#pragma region f64 kernels
+// no polynomial kernels for f64 yet: evaluate lane by lane, still inside the packet loop.
+using f64x = vec_t<f64>;
+
+#define impl_f64x(fn)                        \
+  inline auto fn(f64x x) -> f64x {           \
+    for (usize i = 0; i < lanes<f64>; ++i) { \
+      x[i] = __builtin_##fn(x[i]);           \
+    }                                        \
+    return x;                                \
+  }
+impl_f64x(exp);
+impl_f64x(log);
+impl_f64x(sin);
+impl_f64x(cos);
+impl_f64x(tanh);
+#undef impl_f64x
+#pragma endregion
+
+#pragma region expression trees
+// `Y` packs with `F` if every leaf of `X` can load a packet of `Y`.
+template <class F, class Y, class X, class = void>
+struct CanAssign {
+  static constexpr bool VALUE = false;
+};
+
+template <class F, class Y, class X>
+struct CanAssign<F, Y, X, void_t<decltype(F{}(declval<vec_t<Y>&>(), declval<const X&>().load(0, 1)))>> {
+  static constexpr bool VALUE = __is_same(decltype(declval<const X&>().load(0, 1)), vec_t<Y>);
+};
+
+template <class F, class X, class = void>
+struct CanFold {
+  static constexpr bool VALUE = false;
+};
+
+template <class F, class X>
+struct CanFold<F, X, void_t<decltype(F{}(declval<const X&>().load(0, 1), declval<const X&>().load(0, 1)))>> {
+  using V = decltype(declval<const X&>().load(0, 1));
+  static constexpr bool VALUE = __is_same(decltype(F{}(declval<V>(), declval<V>())), V);
+};
+
+template <class X, class = void>
+struct CanLoad {
+  static constexpr bool VALUE = false;
+};
+
+template <class X>
+struct CanLoad<X, void_t<decltype(declval<const X&>().load(0, 1))>> {
+  static constexpr bool VALUE = true;
+};
+
+template <class F, class Y, class X>
+static constexpr bool can_assign = CanAssign<F, Y, X>::VALUE;
+
+template <class X>
+static constexpr bool can_load = CanLoad<X>::VALUE;
+
+template <class F, class X>
+static constexpr bool can_fold = CanFold<F, X>::VALUE;
+
+// items [i0, i1) of `dst`, which points at item 0.
+template <class F, class Y, class X>
+void assign(Y* dst, usize step, usize i0, usize i1, const X& src) {
+  constexpr auto L = lanes<Y>;
+
+  auto i = i0;
+  for (; i + L <= i1; i += L) {
+    auto y = simd::load(dst + i * step, step, L);
+    F{}(y, src.load(i, L));
+    simd::store(dst + i * step, step, L, y);
+  }
+
+  if (i != i1) {
+    const auto cnt = i1 - i;
+    auto y = simd::load(dst + i * step, step, cnt);
+    F{}(y, src.load(i, cnt));
+    simd::store(dst + i * step, step, cnt, y);
+  }
+}
+
+// items [i0, i1) of `src`, i0 < i1.
+template <class F, class X>
+auto fold(const X& src, usize i0, usize i1) {
+  using V = decltype(src.load(0, 1));
+  using T = remove_const_t<remove_ref_t<decltype(declval<V>()[0])>>;
+  constexpr auto L = sizeof(V) / sizeof(T);
+
+  // lanes, not items: a comparison is a `bool`, but its packet has ints.
+  auto s = T(src[i0]);
+  auto i = i0 + 1;
+  if (i0 + L <= i1) {
+    auto acc = src.load(i0, L);
+    for (i = i0 + L; i + L <= i1; i += L) {
+      acc = F{}(acc, src.load(i, L));
+    }
+    s = acc[0];
+    for (usize k = 1; k < L; ++k) {
+      s = F{}(s, acc[k]);
+    }
+  }
+  for (; i < i1; ++i) {
+    s = F{}(s, src[i]);
+  }
+  return s;
+}
+#pragma endregion
+
+}  // namespace sfc::math::simd
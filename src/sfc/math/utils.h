@@ -23,7 +23,7 @@ struct Linspace {
   using Item = Map<math::Add(T, Element)>;
   auto operator[](usize idx) const -> Item {
     using I = imp::idx_seq_t<RANK - 1>;
-    return {T(idx) * _step[0], *this | I{}};
+    return {T(idx) * _step[RANK - 1], *this | I{}};
   }
 };
 
@@ -41,6 +41,11 @@ struct Linspace<T, 1> {
   auto operator[](usize idx) const -> Item {
     return T(idx) * _step[0];
   }
+
+  template <class U = T, class V = simd::vec_t<U>>
+  auto load(usize idx, usize) const -> V {
+    return (simd::iota<T>() + T(idx)) * _step[0];
+  }
 };
 
 template <class T, class... U>
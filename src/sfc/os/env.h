@@ -10,6 +10,7 @@ void set_env(Str key, Str val);
 auto home_dir() -> Str;
 auto current_dir() -> Str;
 auto current_exe() -> Str;
+auto process_id() -> u32;
 void set_current_dir(Str path);
 
 }  // namespace sfc::os
@@ -55,6 +55,10 @@ auto current_exe() -> Str {
   return Str{ptr::cast<const u8>(buf), usize(cnt - 1)};
 }
 
+auto process_id() -> u32 {
+  return u32(::getpid());
+}
+
 auto current_dir() -> Str {
   static thread_local char buf[PathStr::CAPACITY];
   const auto res = ::getcwd(buf, sizeof(buf));
@@ -0,0 +1,113 @@
+#include "counter.h"
+
+namespace sfc::perf {
+
+auto event_name(Event e) -> Str {
+  switch (e) {
+    case Event::Cycles:
+      return "cycles";
+    case Event::Instructions:
+      return "instructions";
+    case Event::CacheMisses:
+      return "cache_misses";
+    case Event::BranchMisses:
+      return "branch_misses";
+    case Event::PageFaults:
+      return "page_faults";
+  }
+  return "unknown";
+}
+
+#pragma region Counts
+auto Counts::get(Event e) const -> Option<u64> {
+  const auto i = usize(e);
+  if (!(_mask & (1U << i))) {
+    return option::NONE;
+  }
+  return {option::SOME, _vals[i]};
+}
+
+void Counts::set(Event e, u64 val) {
+  const auto i = usize(e);
+  _vals[i] = val;
+  _mask |= u8(1U << i);
+}
+
+auto Counts::is_empty() const -> bool {
+  return _mask == 0;
+}
+
+auto Counts::ipc() const -> Option<f64> {
+  const auto cyc = this->get(Event::Cycles);
+  const auto ins = this->get(Event::Instructions);
+  if (!cyc || !ins || ~cyc == 0) {
+    return option::NONE;
+  }
+  return {option::SOME, f64(~ins) / f64(~cyc)};
+}
+
+auto Counts::operator+(const Counts& other) const -> Counts {
+  auto res = Counts{};
+  for (usize i = 0; i < EVENT_COUNT; ++i) {
+    res._vals[i] = _vals[i] + other._vals[i];
+  }
+  res._mask = u8(_mask | other._mask);
+  return res;
+}
+
+void Counts::format(fmt::Formatter& f) const {
+  auto box = f.debug_struct();
+  for (usize i = 0; i < EVENT_COUNT; ++i) {
+    if (const auto x = this->get(Event(i))) {
+      box.entry(perf::event_name(Event(i)), ~x);
+    }
+  }
+}
+#pragma endregion
+
+#pragma region Counter
+auto Counter::open_default() -> Counter {
+  static const Event ALL[] = {Event::Cycles, Event::Instructions, Event::CacheMisses, Event::BranchMisses,
+                              Event::PageFaults};
+  return Counter::open(ALL);
+}
+
+auto Counter::len() const -> usize {
+  return _len;
+}
+
+auto Counter::is_empty() const -> bool {
+  return _len == 0;
+}
+
+Region::Region(Counter& ctr, Counts& out) : _ctr{ctr}, _out{out} {
+  _ctr.start();
+}
+
+Region::~Region() {
+  _ctr.stop();
+  _out = _out + _ctr.read();
+}
+
+#if !defined(__linux__)
+Counter::~Counter() {}
+
+Counter::Counter(Counter&& other) noexcept : _len{other._len} {
+  other._len = 0;
+}
+
+auto Counter::open(Slice<const Event>) -> Counter {
+  return Counter{};
+}
+
+void Counter::start() {}
+
+void Counter::stop() {}
+
+auto Counter::read() const -> Counts {
+  return Counts{};
+}
+#endif
+#pragma endregion
+
+}  // namespace sfc::perf
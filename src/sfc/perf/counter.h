@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../alloc.h"
+
+namespace sfc::perf {
+
+enum struct Event : u8 {
+  Cycles,
+  Instructions,
+  CacheMisses,
+  BranchMisses,
+  PageFaults,
+};
+
+inline constexpr usize EVENT_COUNT = 5;
+
+auto event_name(Event e) -> Str;
+
+// what a counter group read; events the group could not open are None.
+struct Counts {
+  u64 _vals[EVENT_COUNT] = {};
+  u8 _mask = 0;  // a bit per `Event` that was counted
+
+  auto get(Event e) const -> Option<u64>;
+  void set(Event e, u64 val);
+  auto is_empty() const -> bool;
+
+  // instructions per cycle, when both were counted.
+  auto ipc() const -> Option<f64>;
+
+  auto operator+(const Counts& other) const -> Counts;
+
+  void format(fmt::Formatter& f) const;
+};
+
+// a group of counters on the calling thread, enabled, disabled and read as
+// one so that ratios between them hold. each event the kernel will not give
+// us (no pmu in a vm, perf_event_paranoid, not linux) is left out, so a
+// group may well be empty, and then costs nothing.
+//   auto ctr = perf::Counter::open_default();
+//   const auto cnt = ctr.measure([&] { parse(text); });
+//   log::info("{}", cnt);
+struct Counter {
+  int _fds[EVENT_COUNT];
+  Event _events[EVENT_COUNT];
+  usize _len = 0;
+
+  Counter() = default;
+  ~Counter();
+  Counter(Counter&& other) noexcept;
+  Counter(const Counter&) = delete;
+
+  static auto open(Slice<const Event> events) -> Counter;
+  static auto open_default() -> Counter;
+
+  auto len() const -> usize;
+  auto is_empty() const -> bool;
+
+  // zeroes the counters and starts them.
+  void start();
+  void stop();
+
+  // the counts so far, scaled up for the time the kernel had the group
+  // multiplexed out.
+  auto read() const -> Counts;
+
+  template <class F>
+  auto measure(F&& f) -> Counts {
+    this->start();
+    f();
+    this->stop();
+    return this->read();
+  }
+};
+
+// counts while it lives, and adds the result to `out`.
+struct Region {
+  Counter& _ctr;
+  Counts& _out;
+
+  Region(Counter& ctr, Counts& out);
+  ~Region();
+  Region(const Region&) = delete;
+};
+
+}  // namespace sfc::perf
@@ -0,0 +1,115 @@
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "../counter.h"
+
+namespace sfc::perf {
+
+static auto event_attr(Event e) -> perf_event_attr {
+  auto attr = perf_event_attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  switch (e) {
+    case Event::Cycles:
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case Event::Instructions:
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case Event::CacheMisses:
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    case Event::BranchMisses:
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+    case Event::PageFaults:
+      attr.type = PERF_TYPE_SOFTWARE;
+      attr.config = PERF_COUNT_SW_PAGE_FAULTS;
+      break;
+  }
+  // user space only: that is all perf_event_paranoid=2 allows anyway.
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return attr;
+}
+
+Counter::~Counter() {
+  for (usize i = _len; i > 0; --i) {
+    ::close(_fds[i - 1]);
+  }
+}
+
+Counter::Counter(Counter&& other) noexcept : _len{other._len} {
+  for (usize i = 0; i < _len; ++i) {
+    _fds[i] = other._fds[i];
+    _events[i] = other._events[i];
+  }
+  other._len = 0;
+}
+
+// the first event that opens leads the group; the leader starts disabled,
+// and the others follow it.
+auto Counter::open(Slice<const Event> events) -> Counter {
+  auto res = Counter{};
+  for (usize i = 0; i < events.len() && res._len < EVENT_COUNT; ++i) {
+    auto attr = event_attr(events[i]);
+    attr.disabled = res._len == 0 ? 1 : 0;
+    const auto group = res._len == 0 ? -1 : res._fds[0];
+    const auto fd = ::syscall(SYS_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC);
+    if (fd < 0) {
+      continue;
+    }
+    res._fds[res._len] = int(fd);
+    res._events[res._len] = events[i];
+    res._len += 1;
+  }
+  return res;
+}
+
+void Counter::start() {
+  if (_len == 0) {
+    return;
+  }
+  ::ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ::ioctl(_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void Counter::stop() {
+  if (_len == 0) {
+    return;
+  }
+  ::ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+auto Counter::read() const -> Counts {
+  auto res = Counts{};
+  if (_len == 0) {
+    return res;
+  }
+
+  // { nr, time_enabled, time_running, value[nr] }
+  u64 buf[3 + EVENT_COUNT] = {};
+  const auto cnt = ::read(_fds[0], buf, sizeof(buf));
+  if (cnt < isize(3 * sizeof(u64)) || buf[0] != _len) {
+    return res;
+  }
+
+  const auto enabled = buf[1];
+  const auto running = buf[2];
+  for (usize i = 0; i < _len; ++i) {
+    const auto val = running == 0         ? 0
+                     : running == enabled ? buf[3 + i]
+                                          : u64(f64(buf[3 + i]) * f64(enabled) / f64(running));
+    res.set(_events[i], val);
+  }
+  return res;
+}
+
+}  // namespace sfc::perf
+
+#endif
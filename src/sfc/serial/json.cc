@@ -9,6 +9,11 @@ struct Parser {
     return c == ' ' || c == '\n' || c == '\t' || c == '\r';
   }
 
+  void skip_blank() {
+    const auto idx = _inn.iter()->find([](auto c) { return !is_blank(c); });
+    _inn = _inn.slice_unchecked({idx.is_some() ? ~idx : _inn.len(), _inn.len()});
+  }
+
   auto top() const -> char {
     return char(_inn.get_unchecked(0));
   }
@@ -28,20 +33,19 @@ struct Parser {
   }
 
   auto extract_chr(u8 c) -> Option<u8> {
-    _inn.trim_start();
+    this->skip_blank();
 
-    if (this->top() != c) return option::NONE;
+    if (_inn.is_empty() || this->top() != c) return option::NONE;
     this->pop();
     return {option::SOME, c};
   }
 
   auto extract_num() -> Option<Str> {
-    this->pop();  // .
+    const auto idx = _inn.iter()->find([](auto c) { return c == ',' || c == ']' || c == '}' || is_blank(c); });
 
-    const auto idx = _inn.iter()->find([](auto c) { return c == ',' || c == ']' || c == '}'; });
-    if (idx.is_none()) return option::NONE;
+    auto [res, rem] = _inn.split_at(idx.is_some() ? ~idx : _inn.len());
+    if (res.is_empty()) return option::NONE;
 
-    auto [res, rem] = _inn.split_at(~idx);
     _inn = rem;
     return {option::SOME, res};
   }
@@ -68,7 +72,7 @@ struct Parser {
   }
 
   auto parse_false() -> Option<Node> {
-    return this->extract("false").map([](auto&&) { return Node(true); });
+    return this->extract("false").map([](auto&&) { return Node(false); });
   }
 
   auto parse_num() -> Option<Node> {
@@ -118,13 +122,14 @@ struct Parser {
 
     // }
     if (this->extract_chr('}')) {
-      return option::NONE;
+      return {option::SOME, Node(Tag::Dict)};
     }
 
     auto res = Node(Tag::Dict);
     auto& obj = ~res.as_dict_mut();
 
     while (true) {
+      this->skip_blank();
       auto key = this->extract_str();
       if (key.is_none()) return option::NONE;
 
@@ -136,13 +141,16 @@ struct Parser {
       obj.insert(~key, sfc::move(~val));
 
       if (this->extract_chr(',')) continue;
-      if (this->extract_chr(']')) break;
+      if (this->extract_chr('}')) break;
       return option::NONE;
     }
     return {option::SOME, sfc::move(res)};
   }
 
   auto parse() -> Option<Node> {
+    this->skip_blank();
+    if (_inn.is_empty()) return option::NONE;
+
     const auto c = this->top();
 
     switch (c) {
@@ -184,6 +192,189 @@ struct Parser {
   }
 };
 
+// on-demand lookup: walks the raw text and skips unrelated values
+// by bracket and quote matching, without building any `Node`.
+struct Lookup {
+  const u8* _ptr;
+  const u8* _end;
+
+  static auto from_str(Str s) -> Lookup {
+    return Lookup{s.as_ptr(), s.as_ptr() + s.len()};
+  }
+
+  // json-pointer(rfc6901): `~1` -> '/', `~0` -> '~'
+  static auto token_eq(Str token, Str key) -> bool {
+    auto p = token.as_ptr();
+    auto q = key.as_ptr();
+    const auto p_end = p + token.len();
+    const auto q_end = q + key.len();
+
+    for (; p != p_end && q != q_end; ++p, ++q) {
+      auto c = *p;
+      if (c == '~' && p + 1 != p_end && (p[1] == '0' || p[1] == '1')) {
+        c = p[1] == '0' ? '~' : '/';
+        p += 1;
+      }
+      if (c != *q) return false;
+    }
+    return p == p_end && q == q_end;
+  }
+
+  static auto token_idx(Str token) -> Option<usize> {
+    if (token.is_empty() || (token.len() > 1 && token[0] == '0')) {
+      return option::NONE;
+    }
+
+    auto res = usize(0);
+    for (auto itr = token.iter(); auto c = itr.next();) {
+      const auto n = usize(~c - '0');
+      if (n >= 10) return option::NONE;
+      res = res * 10 + n;
+    }
+    return {option::SOME, res};
+  }
+
+  auto skip_blank() -> u8 {
+    while (_ptr != _end && Parser::is_blank(char(*_ptr))) {
+      _ptr += 1;
+    }
+    return _ptr == _end ? u8(0) : *_ptr;
+  }
+
+  auto eat(u8 c) -> bool {
+    if (this->skip_blank() != c) return false;
+    _ptr += 1;
+    return true;
+  }
+
+  // "..."
+  auto skip_str() -> bool {
+    for (_ptr += 1; _ptr != _end; _ptr += 1) {
+      const auto c = *_ptr;
+      if (c == '\\') {
+        if (_end - _ptr < 2) return false;
+        _ptr += 1;
+        continue;
+      }
+      if (c == '"') {
+        _ptr += 1;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // [...] or {...}
+  auto skip_nested() -> bool {
+    auto depth = usize(0);
+    while (_ptr != _end) {
+      const auto c = *_ptr;
+      if (c == '"') {
+        if (!this->skip_str()) return false;
+        continue;
+      }
+
+      _ptr += 1;
+      if (c == '[' || c == '{') {
+        depth += 1;
+      } else if (c == ']' || c == '}') {
+        if (--depth == 0) return true;
+      }
+    }
+    return false;
+  }
+
+  // null, true, false, number
+  auto skip_atom() -> bool {
+    const auto start = _ptr;
+    while (_ptr != _end) {
+      const auto c = *_ptr;
+      if (c == ',' || c == ']' || c == '}' || Parser::is_blank(char(c))) break;
+      _ptr += 1;
+    }
+    return _ptr != start;
+  }
+
+  auto skip_value() -> bool {
+    switch (this->skip_blank()) {
+      case 0:
+        return false;
+      case '"':
+        return this->skip_str();
+      case '[':
+      case '{':
+        return this->skip_nested();
+      default:
+        return this->skip_atom();
+    }
+  }
+
+  auto extract_key() -> Option<Str> {
+    if (this->skip_blank() != '"') return option::NONE;
+
+    const auto start = _ptr + 1;
+    if (!this->skip_str()) return option::NONE;
+    return {option::SOME, Str{start, usize(_ptr - 1 - start)}};
+  }
+
+  auto select_member(Str token) -> bool {
+    _ptr += 1;  // {
+    if (this->eat('}')) return false;
+
+    while (true) {
+      const auto key = this->extract_key();
+      if (key.is_none() || !this->eat(':')) return false;
+
+      if (Lookup::token_eq(token, ~key)) return true;
+
+      if (!this->skip_value()) return false;
+      if (!this->eat(',')) return false;
+    }
+  }
+
+  auto select_element(Str token) -> bool {
+    const auto idx = Lookup::token_idx(token);
+    if (idx.is_none()) return false;
+
+    _ptr += 1;  // [
+    if (this->eat(']')) return false;
+
+    for (auto i = usize(0); i < ~idx; ++i) {
+      if (!this->skip_value()) return false;
+      if (!this->eat(',')) return false;
+    }
+    return true;
+  }
+
+  auto select(Str path) -> Option<Str> {
+    while (!path.is_empty()) {
+      if (path[0] != '/') return option::NONE;
+
+      const auto rest = path.slice_unchecked({1, path.len()});
+      const auto end = rest.iter()->find([](auto c) { return c == '/'; }).unwrap_or(rest.len());
+      const auto token = rest.slice_unchecked({0, end});
+      path = rest.slice_unchecked({end, rest.len()});
+
+      const auto found = [&]() {
+        switch (this->skip_blank()) {
+          case '{':
+            return this->select_member(token);
+          case '[':
+            return this->select_element(token);
+          default:
+            return false;
+        }
+      }();
+      if (!found) return option::NONE;
+    }
+
+    this->skip_blank();
+    const auto start = _ptr;
+    if (!this->skip_value()) return option::NONE;
+    return {option::SOME, Str{start, usize(_ptr - start)}};
+  }
+};
+
 }  // namespace sfc::serial::json
 
 namespace sfc::serial {
@@ -192,6 +383,14 @@ auto Json::from_str(Str s) -> Option<Node> {
   return json::Parser{s}.parse();
 }
 
+auto Json::lookup(Str s, Str path) -> Option<Str> {
+  return json::Lookup::from_str(s).select(path);
+}
+
+auto Json::query(Str s, Str path) -> Option<Node> {
+  return Json::lookup(s, path).and_then([](Str raw) { return json::Parser{raw}.parse(); });
+}
+
 void Json::format(fmt::Formatter& f) const {
   const auto tag = this->tag();
 
@@ -138,11 +138,11 @@ auto List::iter_mut() -> IterMut {
 }
 
 auto List::operator[](usize idx) const -> const Node& {
-  return (*this)[idx];
+  return (**this)[idx];
 }
 
 auto List::operator[](usize idx) -> Node& {
-  return (*this)[idx];
+  return (**this)[idx];
 }
 
 void List::push(Node val) {
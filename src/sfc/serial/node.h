@@ -140,6 +140,11 @@ struct Json : Node {
   ~Json() = delete;
 
   static auto from_str(Str s) -> Option<Node>;
+
+  // json-pointer path, like `/a/b/3/c`; unrelated subtrees are skipped, not parsed.
+  static auto lookup(Str s, Str path) -> Option<Str>;
+  static auto query(Str s, Str path) -> Option<Node>;
+
   void format(fmt::Formatter&) const;
 };
 
@@ -1,5 +1,9 @@
 #pragma once
 
 #include "sync/arc.h"
+#include "sync/channel.h"
 #include "sync/condvar.h"
+#include "sync/epoch.h"
 #include "sync/mutex.h"
+#include "sync/rwlock.h"
+#include "sync/seqlock.h"
@@ -4,36 +4,15 @@
 
 namespace sfc::sync {
 
-static constexpr auto MAX_REFCOUNT = num::U32::max_value();
+// beyond this the count is surely leaking, and would soon wrap around.
+static constexpr auto MAX_REFCOUNT = num::U32::max_value() / 2;
 
 template <class T>
 struct ArcInner {
   Atomic<u32> _strong;
-  Atomic<u32> _weak;
   T _data;
 };
 
-template <class T>
-struct Weak {
-  using Inner = ArcInner<T>;
-  ptr::Unique<Inner> _0;
-
-  explicit Weak(ptr::Unique<Inner> p) : _0{sfc::move(p)} {}
-
-  Weak(Weak&&) noexcept = default;
-
-  Weak(const Weak& other) : _0{other._0.clone()} {
-    _0->_weak.fetch_add(1, Ordering::Relaxed);
-  }
-
-  ~Weak() {
-    if (_0.is_null()) return;
-    if (_0->_weak.fetch_sub(1) != 1) return;
-    
-    alloc::Global::dealloc(_0.ptr(), alloc::Layout::one<T>());
-  }
-};
-
 template <class T>
 struct Arc {
   using Inner = ArcInner<T>;
@@ -44,31 +23,55 @@ struct Arc {
 
   Arc(Arc&&) noexcept = default;
 
+  // a new reference is made from an existing one, which already keeps the
+  // data alive, so the increment needs no ordering.
   Arc(const Arc& other) : _0{other._0.clone()} {
-    _0->_strong.fetch_add(1);
+    const auto old = _0->_strong.fetch_add(1, Ordering::Relaxed);
+    if (old > MAX_REFCOUNT) {
+      panicking::panic("sync::Arc: refcount overflow");
+    }
   }
 
+  // every use of the data happens before the last decrement (Release), which
+  // the fence then makes visible to the thread that destroys it (Acquire).
   ~Arc() {
-    if (_0.is_null() || _0->_strong.fetch_sub(1) != 1) {
+    if (_0.is_null() || _0->_strong.fetch_sub(1, Ordering::Release) != 1) {
       return;
     }
-
-    // ThreadSanitizer does not support memory fences. To avoid false positive
-    // reports in Arc / Weak implementation use atomic loads for synchronization
-    // instead.
-    _0->_strong.load(Ordering::Acquire);
+    sync::atomic_fence(Ordering::Acquire);
 
     // slow drop
     mem::drop(_0->_data);
-    (void)Weak{sfc::move(_0)};
+    alloc::GLOBAL.dealloc_one(_0._0);
   }
 
-  explicit Arc(T data) : _0{BoxIn{Inner{Atomic{1u}, Atomic{1u}, sfc::move(data)}}.into_raw()} {}
+  explicit Arc(T data) : _0{BoxIn{Inner{Atomic{1u}, sfc::move(data)}}.into_raw()} {}
 
   auto is_null() const -> bool {
     return _0.is_null();
   }
 
+  auto strong_count() const -> usize {
+    return _0->_strong.load(Ordering::Relaxed);
+  }
+
+  // the data, for writing: shared data is cloned first, so that the other
+  // references keep seeing the old value.
+  auto make_mut() -> T& {
+    if (_0->_strong.load(Ordering::Acquire) != 1) {
+      *this = Arc{T{_0->_data}};
+    }
+    return _0->_data;
+  }
+
+  auto operator=(Arc&& other) noexcept -> Arc& {
+    if (this != &other) {
+      auto tmp = sfc::move(*this);
+      _0 = sfc::move(other._0);
+    }
+    return *this;
+  }
+
   auto operator*() const -> const T& {
     return _0->_data;
   }
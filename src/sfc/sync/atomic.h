@@ -32,7 +32,11 @@ struct Atomic {
   }
 
   auto compare_exchange(T expect, T desired, Ordering order = Ordering::SeqCst) -> bool {
-    return __atomic_compare_exchange_strong(&_val, &expect, desired, false, order, order);
+    // a failed exchange only loads, so it can not release.
+    const auto fail = order == Ordering::Release ? Ordering::Relaxed
+                      : order == Ordering::AcqRel ? Ordering::Acquire
+                                                  : order;
+    return __atomic_compare_exchange_n(&_val, &expect, desired, false, order, fail);
   }
 
   auto fetch_add(T val, Ordering order = Ordering::SeqCst) -> T {
@@ -60,6 +64,30 @@ struct Atomic {
   }
 };
 
+template <class T>
+struct Atomic<T*> {
+  T* _val;
+
+  void store(T* val, Ordering order = Ordering::SeqCst) {
+    __atomic_store_n(&_val, val, order);
+  }
+
+  auto load(Ordering order = Ordering::SeqCst) const -> T* {
+    return __atomic_load_n(&_val, order);
+  }
+
+  auto exchange(T* val, Ordering order = Ordering::SeqCst) -> T* {
+    return __atomic_exchange_n(&_val, val, order);
+  }
+
+  auto compare_exchange(T* expect, T* desired, Ordering order = Ordering::SeqCst) -> bool {
+    const auto fail = order == Ordering::Release ? Ordering::Relaxed
+                      : order == Ordering::AcqRel ? Ordering::Acquire
+                                                  : order;
+    return __atomic_compare_exchange_n(&_val, &expect, desired, false, order, fail);
+  }
+};
+
 template <class T>
 Atomic(T) -> Atomic<T>;
 
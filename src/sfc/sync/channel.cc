@@ -0,0 +1,47 @@
+#include "channel.h"
+
+#include "condvar.h"
+
+namespace sfc::sync::channel::imp {
+
+#ifdef __linux__
+void Notifier::wait(u32 epoch) {
+  futex::wait(_epoch, epoch);
+  _waiters.fetch_sub(1, Ordering::Relaxed);
+}
+
+void Notifier::_notify(bool all) {
+  _epoch.fetch_add(1, Ordering::SeqCst);
+  if (all) {
+    futex::wake_all(_epoch);
+  } else {
+    futex::wake_one(_epoch);
+  }
+}
+#else
+// without futexes every notifier shares one lock and wakes all sleepers.
+static auto _parking() -> Tuple<Mutex, Condvar>& {
+  static Tuple<Mutex, Condvar> res{};
+  return res;
+}
+
+void Notifier::wait(u32 epoch) {
+  auto& [mtx, cnd] = _parking();
+  {
+    auto lock = mtx.lock();
+    while (_epoch.load(Ordering::SeqCst) == epoch) {
+      cnd.wait(lock);
+    }
+  }
+  _waiters.fetch_sub(1, Ordering::Relaxed);
+}
+
+void Notifier::_notify(bool) {
+  auto& [mtx, cnd] = _parking();
+  auto lock = mtx.lock();
+  _epoch.fetch_add(1, Ordering::SeqCst);
+  cnd.notify_all();
+}
+#endif
+
+}  // namespace sfc::sync::channel::imp
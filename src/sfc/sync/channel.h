@@ -0,0 +1,435 @@
+#pragma once
+
+#include "arc.h"
+#include "futex.h"
+
+namespace sfc::sync::channel {
+
+namespace imp {
+
+// threads sleep until `_epoch` moves; notifying is one load while nobody
+// sleeps. a waiter calls `prepare`, checks its condition again, and then
+// either `cancel`s or `wait`s, so that a notify in between is not lost.
+struct Notifier {
+  Atomic<u32> _epoch;
+  Atomic<u32> _waiters;
+
+  auto prepare() -> u32 {
+    _waiters.fetch_add(1, Ordering::SeqCst);
+    return _epoch.load(Ordering::SeqCst);
+  }
+
+  void cancel() {
+    _waiters.fetch_sub(1, Ordering::Relaxed);
+  }
+
+  void wait(u32 epoch);
+
+  void notify_one() {
+    sync::atomic_fence(Ordering::SeqCst);
+    if (_waiters.load(Ordering::Relaxed) != 0) {
+      this->_notify(false);
+    }
+  }
+
+  void notify_all() {
+    sync::atomic_fence(Ordering::SeqCst);
+    if (_waiters.load(Ordering::Relaxed) != 0) {
+      this->_notify(true);
+    }
+  }
+
+  void _notify(bool all);
+};
+
+inline auto ring_capacity(usize cap) -> usize {
+  auto n = usize(2);
+  while (n < cap) {
+    n <<= 1;
+  }
+  return n;
+}
+
+template <class T>
+struct MpmcSlot {
+  Atomic<usize> _seq;
+  alignas(T) u8 _buf[sizeof(T)];
+
+  auto ptr() -> T* {
+    return _buf % as<T*>;
+  }
+};
+
+// Vyukov's bounded queue: slot `i` takes a push when its `_seq == i`, and a
+// pop when `_seq == i + 1`, so producers and consumers only share a slot.
+template <class T>
+struct Mpmc {
+  static constexpr bool MULTI = true;
+  using Slot = MpmcSlot<T>;
+
+  ptr::Unique<Slot> _slots;
+  usize _mask;
+  alignas(64) Atomic<usize> _head;
+  alignas(64) Atomic<usize> _tail;
+
+  static auto with_capacity(usize cap) -> Mpmc {
+    const auto n = imp::ring_capacity(cap);
+    const auto p = alloc::GLOBAL.alloc_array<Slot>(n);
+    for (usize i = 0; i < n; ++i) {
+      p[i]._seq.store(i, Ordering::Relaxed);
+    }
+    return Mpmc{p, n - 1, {0}, {0}};
+  }
+
+  Mpmc(ptr::Unique<Slot> slots, usize mask, Atomic<usize> head, Atomic<usize> tail)
+      : _slots{sfc::move(slots)}, _mask{mask}, _head{head}, _tail{tail} {}
+
+  Mpmc(Mpmc&&) noexcept = default;
+
+  ~Mpmc() {
+    if (_slots.is_null()) {
+      return;
+    }
+    while (this->try_pop()) {
+    }
+    alloc::GLOBAL.dealloc_array(_slots._0, _mask + 1);
+  }
+
+  auto capacity() const -> usize {
+    return _mask + 1;
+  }
+
+  // moves `val` in, unless the queue is full.
+  auto try_push(T& val) -> bool {
+    auto pos = _tail.load(Ordering::Relaxed);
+    while (true) {
+      auto& slot = _slots._0[pos & _mask];
+      const auto dif = isize(slot._seq.load(Ordering::Acquire) - pos);
+      if (dif == 0) {
+        if (_tail.compare_exchange(pos, pos + 1, Ordering::Relaxed)) {
+          ptr::write(slot.ptr(), sfc::move(val));
+          slot._seq.store(pos + 1, Ordering::Release);
+          return true;
+        }
+      } else if (dif < 0) {
+        return false;
+      }
+      pos = _tail.load(Ordering::Relaxed);
+    }
+  }
+
+  auto try_pop() -> Option<T> {
+    auto pos = _head.load(Ordering::Relaxed);
+    while (true) {
+      auto& slot = _slots._0[pos & _mask];
+      const auto dif = isize(slot._seq.load(Ordering::Acquire) - (pos + 1));
+      if (dif == 0) {
+        if (_head.compare_exchange(pos, pos + 1, Ordering::Relaxed)) {
+          auto res = ptr::read(slot.ptr());
+          slot._seq.store(pos + _mask + 1, Ordering::Release);
+          return {option::SOME, sfc::move(res)};
+        }
+      } else if (dif < 0) {
+        return option::NONE;
+      }
+      pos = _head.load(Ordering::Relaxed);
+    }
+  }
+};
+
+// one producer, one consumer: each side owns its index and caches the
+// other's, which it reloads only when the ring looks full (or empty).
+template <class T>
+struct Spsc {
+  static constexpr bool MULTI = false;
+
+  ptr::Unique<T> _buf;
+  usize _mask;
+  alignas(64) Atomic<usize> _head;
+  usize _tail_cache;
+  alignas(64) Atomic<usize> _tail;
+  usize _head_cache;
+
+  static auto with_capacity(usize cap) -> Spsc {
+    const auto n = imp::ring_capacity(cap);
+    return Spsc{alloc::GLOBAL.alloc_array<T>(n), n - 1};
+  }
+
+  Spsc(ptr::Unique<T> buf, usize mask)
+      : _buf{sfc::move(buf)}, _mask{mask}, _head{0}, _tail_cache{0}, _tail{0}, _head_cache{0} {}
+
+  Spsc(Spsc&&) noexcept = default;
+
+  ~Spsc() {
+    if (_buf.is_null()) {
+      return;
+    }
+    while (this->try_pop()) {
+    }
+    alloc::GLOBAL.dealloc_array(_buf._0, _mask + 1);
+  }
+
+  auto capacity() const -> usize {
+    return _mask + 1;
+  }
+
+  auto try_push(T& val) -> bool {
+    const auto t = _tail.load(Ordering::Relaxed);
+    if (t - _head_cache > _mask) {
+      _head_cache = _head.load(Ordering::Acquire);
+      if (t - _head_cache > _mask) {
+        return false;
+      }
+    }
+    ptr::write(_buf._0 + (t & _mask), sfc::move(val));
+    _tail.store(t + 1, Ordering::Release);
+    return true;
+  }
+
+  auto try_pop() -> Option<T> {
+    const auto h = _head.load(Ordering::Relaxed);
+    if (h == _tail_cache) {
+      _tail_cache = _tail.load(Ordering::Acquire);
+      if (h == _tail_cache) {
+        return option::NONE;
+      }
+    }
+    auto res = ptr::read(_buf._0 + (h & _mask));
+    _head.store(h + 1, Ordering::Release);
+    return {option::SOME, sfc::move(res)};
+  }
+};
+
+template <class Q>
+struct Shared {
+  Q _queue;
+  Notifier _not_empty;
+  Notifier _not_full;
+  Atomic<u32> _senders;
+  Atomic<u32> _receivers;
+};
+
+// spins are cheap next to a futex round trip when the other side is busy.
+static constexpr u32 SPIN_LIMIT = 64;
+
+}  // namespace imp
+
+template <class T, class Q = imp::Mpmc<T>>
+struct Sender {
+  Arc<imp::Shared<Q>> _inner;
+
+  explicit Sender(Arc<imp::Shared<Q>> inner) : _inner{sfc::move(inner)} {}
+
+  Sender(Sender&&) noexcept = default;
+
+  Sender(const Sender& other) : _inner{other._inner} {
+    static_assert(Q::MULTI, "channel: a spsc channel has a single sender");
+    _inner->_senders.fetch_add(1, Ordering::Relaxed);
+  }
+
+  ~Sender() {
+    if (_inner.is_null()) {
+      return;
+    }
+    if (_inner->_senders.fetch_sub(1, Ordering::SeqCst) == 1) {
+      _inner->_not_empty.notify_all();
+    }
+  }
+
+  auto capacity() const -> usize {
+    return _inner->_queue.capacity();
+  }
+
+  // moves `val` in, unless the channel is full or every receiver is gone.
+  auto try_send(T& val) -> bool {
+    auto& s = *_inner;
+    if (s._receivers.load(Ordering::Relaxed) == 0 || !s._queue.try_push(val)) {
+      return false;
+    }
+    s._not_empty.notify_one();
+    return true;
+  }
+
+  // blocks while the channel is full; false (dropping `val`) once every
+  // receiver is gone.
+  auto send(T val) -> bool {
+    auto& s = *_inner;
+    if (s._receivers.load(Ordering::Relaxed) == 0) {
+      return false;
+    }
+    for (u32 i = 0; !s._queue.try_push(val); ++i) {
+      if (s._receivers.load(Ordering::SeqCst) == 0) {
+        return false;
+      }
+      if (i < imp::SPIN_LIMIT) {
+        sync::spin_loop();
+        continue;
+      }
+      const auto epoch = s._not_full.prepare();
+      if (s._queue.try_push(val)) {
+        s._not_full.cancel();
+        break;
+      }
+      if (s._receivers.load(Ordering::SeqCst) == 0) {
+        s._not_full.cancel();
+        return false;
+      }
+      s._not_full.wait(epoch);
+    }
+    s._not_empty.notify_one();
+    return true;
+  }
+
+  // sends every item in order, blocking as needed, and wakes receivers once
+  // per run of pushes instead of once per item; returns how many were sent.
+  auto send_many(Slice<T> vals) -> usize {
+    auto& s = *_inner;
+    auto cnt = usize(0);
+    while (cnt < vals.len() && s._receivers.load(Ordering::Relaxed) != 0) {
+      const auto start = cnt;
+      while (cnt < vals.len() && s._queue.try_push(vals[cnt])) {
+        cnt += 1;
+      }
+      if (cnt != start) {
+        s._not_empty.notify_all();
+      }
+      if (cnt == vals.len()) {
+        break;
+      }
+      const auto epoch = s._not_full.prepare();
+      if (s._queue.try_push(vals[cnt])) {
+        s._not_full.cancel();
+        cnt += 1;
+        continue;
+      }
+      if (s._receivers.load(Ordering::SeqCst) == 0) {
+        s._not_full.cancel();
+        break;
+      }
+      s._not_full.wait(epoch);
+    }
+    return cnt;
+  }
+};
+
+template <class T, class Q = imp::Mpmc<T>>
+struct Receiver {
+  Arc<imp::Shared<Q>> _inner;
+
+  explicit Receiver(Arc<imp::Shared<Q>> inner) : _inner{sfc::move(inner)} {}
+
+  Receiver(Receiver&&) noexcept = default;
+
+  Receiver(const Receiver& other) : _inner{other._inner} {
+    static_assert(Q::MULTI, "channel: a spsc channel has a single receiver");
+    _inner->_receivers.fetch_add(1, Ordering::Relaxed);
+  }
+
+  ~Receiver() {
+    if (_inner.is_null()) {
+      return;
+    }
+    if (_inner->_receivers.fetch_sub(1, Ordering::SeqCst) == 1) {
+      _inner->_not_full.notify_all();
+    }
+  }
+
+  auto capacity() const -> usize {
+    return _inner->_queue.capacity();
+  }
+
+  auto try_recv() -> Option<T> {
+    auto& s = *_inner;
+    auto res = s._queue.try_pop();
+    if (res.is_some()) {
+      s._not_full.notify_one();
+    }
+    return res;
+  }
+
+  // blocks while the channel is empty; none once it is empty and every
+  // sender is gone.
+  auto recv() -> Option<T> {
+    auto& s = *_inner;
+    for (u32 i = 0;; ++i) {
+      if (auto res = s._queue.try_pop()) {
+        s._not_full.notify_one();
+        return res;
+      }
+      if (s._senders.load(Ordering::SeqCst) == 0) {
+        return s._queue.try_pop();
+      }
+      if (i < imp::SPIN_LIMIT) {
+        sync::spin_loop();
+        continue;
+      }
+      const auto epoch = s._not_empty.prepare();
+      if (auto res = s._queue.try_pop()) {
+        s._not_empty.cancel();
+        s._not_full.notify_one();
+        return res;
+      }
+      if (s._senders.load(Ordering::SeqCst) == 0) {
+        s._not_empty.cancel();
+        continue;
+      }
+      s._not_empty.wait(epoch);
+    }
+  }
+
+  // blocks for the first item, then takes whatever else is ready, up to
+  // `max` in total; returns how many were appended to `out`.
+  auto recv_many(Vec<T>& out, usize max) -> usize {
+    if (max == 0) {
+      return 0;
+    }
+    auto first = this->recv();
+    if (first.is_none()) {
+      return 0;
+    }
+    out.push(~sfc::move(first));
+
+    auto& s = *_inner;
+    auto cnt = usize(1);
+    for (; cnt < max; ++cnt) {
+      auto res = s._queue.try_pop();
+      if (res.is_none()) {
+        break;
+      }
+      out.push(~sfc::move(res));
+    }
+    if (cnt > 1) {
+      s._not_full.notify_all();
+    }
+    return cnt;
+  }
+};
+
+template <class T>
+using SpscSender = Sender<T, imp::Spsc<T>>;
+
+template <class T>
+using SpscReceiver = Receiver<T, imp::Spsc<T>>;
+
+template <class T, class Q = imp::Mpmc<T>>
+auto with_queue(usize cap) -> Tuple<Sender<T, Q>, Receiver<T, Q>> {
+  auto inner = Arc{imp::Shared<Q>{Q::with_capacity(cap), {}, {}, {1}, {1}}};
+  auto tx = Sender<T, Q>{inner};
+  auto rx = Receiver<T, Q>{sfc::move(inner)};
+  return {sfc::move(tx), sfc::move(rx)};
+}
+
+// a lock-free channel for any number of senders and receivers; `cap` is
+// rounded up to a power of two.
+template <class T>
+auto bounded(usize cap) -> Tuple<Sender<T>, Receiver<T>> {
+  return channel::with_queue<T, imp::Mpmc<T>>(cap);
+}
+
+// a channel for exactly one sender and one receiver, cheaper than `bounded`.
+template <class T>
+auto spsc(usize cap) -> Tuple<SpscSender<T>, SpscReceiver<T>> {
+  return channel::with_queue<T, imp::Spsc<T>>(cap);
+}
+
+}  // namespace sfc::sync::channel
@@ -11,9 +11,11 @@ struct cnd_t {
 #endif
 
 #ifdef __linux__
-union cnd_t {
-  long _align;
-  char _size[48];
+// `_seq` changes on every notify; `_mtx` is the mutex of the last waiter,
+// which `notify_all` moves the sleepers over to.
+struct cnd_t {
+  Atomic<u32> _seq;
+  Mutex* _mtx;
 };
 #endif
 
@@ -0,0 +1,166 @@
+#include "epoch.h"
+
+#include "mutex.h"
+
+namespace sfc::sync::epoch {
+
+// retired items collected per thread before trying to advance.
+static constexpr usize BAG_LIMIT = 64;
+
+struct Local {
+  Atomic<u64> _state;  // epoch << 1 | pinned
+  usize _depth;
+  Vec<Deferred> _bag;
+};
+
+struct Global {
+  Atomic<u64> _epoch{0};
+  Mutex _mutex{};
+  Vec<Local*> _locals{};
+  Vec<Deferred> _orphans{};
+
+  static auto instance() -> Global& {
+    static auto res = Global{};
+    return res;
+  }
+
+  void enter(Local* local) {
+    auto lock = _mutex.lock();
+    _locals.push(local);
+  }
+
+  // retired items of an exiting thread are left to the others.
+  void leave(Local* local) {
+    auto lock = _mutex.lock();
+    for (usize i = 0; i < _locals.len(); ++i) {
+      if (_locals[i] == local) {
+        _locals.swap_remove(i);
+        break;
+      }
+    }
+    _orphans.append(local->_bag);
+  }
+
+  // the epoch moves on once every pinned thread has seen the current one.
+  auto try_advance() -> u64 {
+    auto orphans = Vec<Deferred>{};
+    auto now = u64(0);
+    {
+      auto lock = _mutex.lock();
+      now = _epoch.load(Ordering::Relaxed);
+      sync::atomic_fence(Ordering::SeqCst);
+      for (usize i = 0; i < _locals.len(); ++i) {
+        const auto s = _locals[i]->_state.load(Ordering::Relaxed);
+        if ((s & 1) && (s >> 1) != now) {
+          return now;
+        }
+      }
+      now += 1;
+      _epoch.store(now, Ordering::Release);
+      orphans.append(_orphans);
+    }
+
+    // deferred functions may pin and retire too, so run them unlocked.
+    Global::collect(orphans, now);
+    if (!orphans.is_empty()) {
+      auto lock = _mutex.lock();
+      _orphans.append(orphans);
+    }
+    return now;
+  }
+
+  // runs the items retired at least two epochs before `now`.
+  static void collect(Vec<Deferred>& bag, u64 now) {
+    auto n = usize(0);
+    for (usize i = 0; i < bag.len(); ++i) {
+      if (bag[i]._epoch + 2 <= now) {
+        bag[i]();
+      } else {
+        bag[n++] = bag[i];
+      }
+    }
+    bag.truncate(n);
+  }
+};
+
+struct Handle {
+  Local* _local = nullptr;
+
+  ~Handle() {
+    if (_local == nullptr) {
+      return;
+    }
+    Global::instance().leave(_local);
+    ptr::drop(_local);
+    alloc::GLOBAL.dealloc_one(_local);
+  }
+
+  auto local() -> Local* {
+    if (_local == nullptr) {
+      _local = alloc::GLOBAL.alloc_one<Local>();
+      ptr::write(_local, Local{{0}, 0, Vec<Deferred>{}});
+      Global::instance().enter(_local);
+    }
+    return _local;
+  }
+};
+
+static auto _local() -> Local* {
+  static thread_local auto handle = Handle{};
+  return handle.local();
+}
+
+#pragma region Guard
+Guard::Guard(Local* local) noexcept : _local{local} {}
+
+Guard::Guard(Guard&& other) noexcept : _local{other._local} {
+  other._local = nullptr;
+}
+
+Guard::~Guard() {
+  if (_local == nullptr || --_local->_depth != 0) {
+    return;
+  }
+  _local->_state.store(0, Ordering::Release);
+}
+
+void Guard::defer(void (*fn)(void*), void* ptr) const {
+  auto& global = Global::instance();
+  _local->_bag.push(Deferred{fn, ptr, global._epoch.load(Ordering::Relaxed)});
+  if (_local->_bag.len() >= BAG_LIMIT) {
+    this->flush();
+  }
+}
+
+void Guard::flush() const {
+  const auto now = Global::instance().try_advance();
+
+  // a deferred function may retire more items into the bag.
+  auto bag = Vec<Deferred>{};
+  bag.append(_local->_bag);
+  Global::collect(bag, now);
+  _local->_bag.append(bag);
+}
+#pragma endregion
+
+// the SeqCst fence orders the store of our epoch before every later load
+// of shared pointers, and pairs with the one in `try_advance`.
+auto pin() -> Guard {
+  const auto local = _local();
+  if (local->_depth++ == 0) {
+    const auto e = Global::instance()._epoch.load(Ordering::Relaxed);
+    local->_state.store(e << 1 | 1, Ordering::Relaxed);
+    sync::atomic_fence(Ordering::SeqCst);
+  }
+  return Guard{local};
+}
+
+auto is_pinned() -> bool {
+  return _local()->_depth != 0;
+}
+
+auto epoch() -> u64 {
+  return Global::instance()._epoch.load(Ordering::Relaxed);
+}
+
+}  // namespace sfc::sync::epoch
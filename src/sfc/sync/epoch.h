@@ -0,0 +1,59 @@
+#pragma once
+
+#include "atomic.h"
+
+namespace sfc::sync::epoch {
+
+// epoch-based reclamation: a node unlinked from a shared structure is not
+// freed at once but retired with `Guard::defer_destroy`. threads `pin()`
+// before reading shared nodes; once every pinned thread has seen a newer
+// global epoch, nothing it read can still be in use, and retired nodes
+// that are two epochs old are destroyed.
+
+struct Local;
+
+struct Deferred {
+  void (*_fn)(void*);
+  void* _ptr;
+  u64 _epoch;
+
+  void operator()() const {
+    _fn(_ptr);
+  }
+};
+
+struct Guard {
+  Local* _local;
+
+  explicit Guard(Local* local) noexcept;
+  ~Guard();
+  Guard(Guard&& other) noexcept;
+  Guard(const Guard&) = delete;
+
+  // runs `fn(ptr)` once no thread can still hold a reference from now.
+  void defer(void (*fn)(void*), void* ptr) const;
+
+  // destroys `*p` and returns its memory to `alloc::GLOBAL`, later.
+  template <class T>
+  void defer_destroy(T* p) const {
+    const auto fn = [](void* x) {
+      const auto t = static_cast<T*>(x);
+      ptr::drop(t);
+      alloc::GLOBAL.dealloc_one(t);
+    };
+    this->defer(fn, p);
+  }
+
+  // tries to advance the epoch, and runs whatever of this thread is due.
+  void flush() const;
+};
+
+// pins the calling thread; pins nest, and are cheap when already pinned.
+auto pin() -> Guard;
+
+auto is_pinned() -> bool;
+
+// the current global epoch, for tests and stats.
+auto epoch() -> u64;
+
+}  // namespace sfc::sync::epoch
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../time.h"
+#include "atomic.h"
+
+namespace sfc::sync {
+
+// a hint for busy-wait loops, e.g. `pause` on x86.
+[[gnu::always_inline]] inline void spin_loop() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+}  // namespace sfc::sync
+
+#ifdef __linux__
+namespace sfc::sync::futex {
+
+// sleeps while `a == expected`, may also return spuriously.
+void wait(const Atomic<u32>& a, u32 expected);
+
+// like `wait`, returns false if `dur` has passed.
+auto wait_timeout(const Atomic<u32>& a, u32 expected, time::Duration dur) -> bool;
+
+void wake_one(const Atomic<u32>& a);
+void wake_all(const Atomic<u32>& a);
+
+// wakes one waiter of `a` and moves the others to wait on `b`, unless
+// `a != expected`; returns false in that case.
+auto requeue(const Atomic<u32>& a, u32 expected, const Atomic<u32>& b) -> bool;
+
+}  // namespace sfc::sync::futex
+#endif
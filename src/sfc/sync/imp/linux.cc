@@ -0,0 +1,269 @@
+#if defined(__linux__)
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../condvar.h"
+#include "../futex.h"
+#include "../mutex.h"
+#include "../rwlock.h"
+
+namespace sfc::sync {
+
+#pragma region futex
+namespace futex {
+
+static auto call(const Atomic<u32>& a, int op, u32 val, const void* arg, const Atomic<u32>* b, u32 val3) -> long {
+  const auto uaddr2 = b == nullptr ? nullptr : &b->_val;
+  return ::syscall(SYS_futex, &a._val, op | FUTEX_PRIVATE_FLAG, val, arg, uaddr2, val3);
+}
+
+void wait(const Atomic<u32>& a, u32 expected) {
+  futex::call(a, FUTEX_WAIT, expected, nullptr, nullptr, 0);
+}
+
+auto wait_timeout(const Atomic<u32>& a, u32 expected, time::Duration dur) -> bool {
+  const auto ts = ::timespec{time_t(dur._secs), long(dur._nanos)};
+  const auto ret = futex::call(a, FUTEX_WAIT, expected, &ts, nullptr, 0);
+  return ret == 0 || errno != ETIMEDOUT;
+}
+
+void wake_one(const Atomic<u32>& a) {
+  futex::call(a, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+}
+
+void wake_all(const Atomic<u32>& a) {
+  futex::call(a, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+auto requeue(const Atomic<u32>& a, u32 expected, const Atomic<u32>& b) -> bool {
+  // the 4th argument is the number of waiters to move, not a timeout.
+  const auto cnt = reinterpret_cast<const void*>(usize(INT_MAX));
+  return futex::call(a, FUTEX_CMP_REQUEUE, 1, cnt, &b, expected) != -1;
+}
+
+}  // namespace futex
+#pragma endregion
+
+namespace imp {
+
+// most critical sections are shorter than a trip through the kernel.
+static constexpr u32 SPIN_LIMIT = 100;
+
+static auto spin_while(const Atomic<u32>& a, u32 busy) -> u32 {
+  for (u32 i = 0; i < SPIN_LIMIT; ++i) {
+    const auto s = a.load(Ordering::Relaxed);
+    if (s != busy) {
+      return s;
+    }
+    sync::spin_loop();
+  }
+  return a.load(Ordering::Relaxed);
+}
+
+static void lock_contended(Atomic<u32>& a) {
+  // spin only while nobody sleeps: then the owner is likely running.
+  auto s = imp::spin_while(a, 1);
+  if (s == 0 && a.compare_exchange(0, 1, Ordering::Acquire)) {
+    return;
+  }
+
+  while (true) {
+    if (s != 2 && a.exchange(2, Ordering::Acquire) == 0) {
+      return;
+    }
+    futex::wait(a, 2);
+    s = imp::spin_while(a, 1);
+  }
+}
+
+// after a condvar wait there may be more sleepers (requeued by notify_all),
+// so take the lock as contended to wake the next one on unlock.
+static void lock_requeued(Atomic<u32>& a) {
+  while (a.exchange(2, Ordering::Acquire) != 0) {
+    futex::wait(a, 2);
+  }
+}
+
+static void unlock(Atomic<u32>& a) {
+  if (a.exchange(0, Ordering::Release) == 2) {
+    futex::wake_one(a);
+  }
+}
+
+}  // namespace imp
+
+#pragma region Mutex
+static_assert(sizeof(Mutex) == 4);
+
+Mutex::Mutex() : _raw{{0}} {}
+
+Mutex::~Mutex() {}
+
+auto Mutex::lock() -> Guard {
+  if (!_raw._state.compare_exchange(0, 1, Ordering::Acquire)) {
+    imp::lock_contended(_raw._state);
+  }
+  return {*this};
+}
+
+auto Mutex::trylock() -> Option<Guard> {
+  if (!_raw._state.compare_exchange(0, 1, Ordering::Acquire)) {
+    return option::NONE;
+  }
+  return {option::SOME, *this};
+}
+
+Mutex::Guard::Guard(Mutex& mtx) : _mtx{&mtx} {}
+
+Mutex::Guard::~Guard() {
+  if (_mtx.is_null()) {
+    return;
+  }
+  imp::unlock(_mtx->_raw._state);
+}
+#pragma endregion
+
+#pragma region Condvar
+Condvar::Condvar() : _raw{{0}, nullptr} {}
+
+Condvar::~Condvar() {}
+
+void Condvar::wait(Mutex::Guard& guard) {
+  auto& mtx = *guard._mtx;
+  const auto seq = _raw._seq.load(Ordering::Relaxed);
+  __atomic_store_n(&_raw._mtx, &mtx, __ATOMIC_RELAXED);
+
+  imp::unlock(mtx._raw._state);
+  futex::wait(_raw._seq, seq);
+  imp::lock_requeued(mtx._raw._state);
+}
+
+auto Condvar::wait_timeout(Mutex::Guard& guard, time::Duration dur) -> bool {
+  auto& mtx = *guard._mtx;
+  const auto seq = _raw._seq.load(Ordering::Relaxed);
+  __atomic_store_n(&_raw._mtx, &mtx, __ATOMIC_RELAXED);
+
+  imp::unlock(mtx._raw._state);
+  const auto res = futex::wait_timeout(_raw._seq, seq, dur);
+  imp::lock_requeued(mtx._raw._state);
+  return res;
+}
+
+void Condvar::notify_one() {
+  _raw._seq.fetch_add(1, Ordering::Relaxed);
+  futex::wake_one(_raw._seq);
+}
+
+// wakes one waiter and moves the rest onto the mutex, where unlock hands
+// it on one by one, instead of waking all of them to fight over the lock.
+void Condvar::notify_all() {
+  const auto seq = _raw._seq.fetch_add(1, Ordering::Relaxed) + 1;
+  const auto mtx = __atomic_load_n(&_raw._mtx, __ATOMIC_RELAXED);
+  if (mtx == nullptr || !futex::requeue(_raw._seq, seq, mtx->_raw._state)) {
+    futex::wake_all(_raw._seq);
+  }
+}
+#pragma endregion
+
+#pragma region RwLock
+// a sleeping writer also sets RW_PARKED_WRITER, which holds back new readers.
+static constexpr u32 RW_WRITER = 1u << 31;
+static constexpr u32 RW_SLEEPER = 1u << 30;
+static constexpr u32 RW_PARKED_WRITER = 1u << 29;
+static constexpr u32 RW_READERS = RW_PARKED_WRITER - 1;
+
+RwLock::RwLock() : _raw{{0}} {}
+
+RwLock::~RwLock() {}
+
+auto RwLock::read() -> ReadGuard {
+  auto& a = _raw._state;
+  for (u32 i = 0;; ++i) {
+    const auto s = a.load(Ordering::Relaxed);
+    if ((s & (RW_WRITER | RW_PARKED_WRITER)) == 0) {
+      if (a.compare_exchange(s, s + 1, Ordering::Acquire)) {
+        return {*this};
+      }
+      continue;
+    }
+    if (i < imp::SPIN_LIMIT) {
+      sync::spin_loop();
+      continue;
+    }
+    if ((s & RW_SLEEPER) || a.compare_exchange(s, s | RW_SLEEPER, Ordering::Relaxed)) {
+      futex::wait(a, s | RW_SLEEPER);
+    }
+  }
+}
+
+auto RwLock::try_read() -> Option<ReadGuard> {
+  const auto s = _raw._state.load(Ordering::Relaxed);
+  if ((s & (RW_WRITER | RW_PARKED_WRITER)) != 0 || !_raw._state.compare_exchange(s, s + 1, Ordering::Acquire)) {
+    return option::NONE;
+  }
+  return {option::SOME, *this};
+}
+
+auto RwLock::write() -> WriteGuard {
+  auto& a = _raw._state;
+  for (u32 i = 0;; ++i) {
+    const auto s = a.load(Ordering::Relaxed);
+    if ((s & (RW_WRITER | RW_READERS)) == 0) {
+      // other parked writers set their bit again when they wake up.
+      if (a.compare_exchange(s, (s & RW_SLEEPER) | RW_WRITER, Ordering::Acquire)) {
+        return {*this};
+      }
+      continue;
+    }
+    if (i < imp::SPIN_LIMIT) {
+      sync::spin_loop();
+      continue;
+    }
+    const auto parked = s | RW_SLEEPER | RW_PARKED_WRITER;
+    if (s == parked || a.compare_exchange(s, parked, Ordering::Relaxed)) {
+      futex::wait(a, parked);
+    }
+  }
+}
+
+auto RwLock::try_write() -> Option<WriteGuard> {
+  if (!_raw._state.compare_exchange(0, RW_WRITER, Ordering::Acquire)) {
+    return option::NONE;
+  }
+  return {option::SOME, *this};
+}
+
+RwLock::ReadGuard::ReadGuard(RwLock& lock) : _lock{&lock} {}
+
+RwLock::ReadGuard::~ReadGuard() {
+  if (_lock.is_null()) {
+    return;
+  }
+  auto& a = _lock->_raw._state;
+  const auto s = a.fetch_sub(1, Ordering::Release) - 1;
+  if ((s & RW_READERS) == 0 && (s & RW_SLEEPER) && a.compare_exchange(s, 0, Ordering::Relaxed)) {
+    futex::wake_all(a);
+  }
+}
+
+RwLock::WriteGuard::WriteGuard(RwLock& lock) : _lock{&lock} {}
+
+RwLock::WriteGuard::~WriteGuard() {
+  if (_lock.is_null()) {
+    return;
+  }
+  auto& a = _lock->_raw._state;
+  if (a.exchange(0, Ordering::Release) & RW_SLEEPER) {
+    futex::wake_all(a);
+  }
+}
+#pragma endregion
+
+}  // namespace sfc::sync
+
+#endif
@@ -1,4 +1,4 @@
-#if defined(__unix__) || defined(__APPLE__)
+#if (defined(__unix__) && !defined(__linux__)) || defined(__APPLE__)
 
 #include <errno.h>
 #include <pthread.h>
@@ -6,6 +6,7 @@
 #include "../../os.h"
 #include "../condvar.h"
 #include "../mutex.h"
+#include "../rwlock.h"
 
 namespace sfc::sync {
 
@@ -19,6 +20,11 @@ static auto operator&(cnd_t& cnd) -> ::pthread_cond_t* {
   return __builtin_addressof(cnd) % as<::pthread_cond_t*>;
 }
 
+static auto operator&(rwl_t& rwl) -> ::pthread_rwlock_t* {
+  static_assert(sizeof(rwl_t) == sizeof(pthread_rwlock_t));
+  return __builtin_addressof(rwl) % as<::pthread_rwlock_t*>;
+}
+
 Mutex::Mutex() {
   ::pthread_mutex_init(&_raw, nullptr);
 }
@@ -99,6 +105,72 @@ void Condvar::notify_all() {
   }
 }
 
+RwLock::RwLock() {
+  ::pthread_rwlock_init(&_raw, nullptr);
+}
+
+RwLock::~RwLock() {
+  ::pthread_rwlock_destroy(&_raw);
+}
+
+auto RwLock::read() -> ReadGuard {
+  const auto eid = ::pthread_rwlock_rdlock(&_raw);
+  if (eid != 0) {
+    throw os::Error{eid};
+  }
+  return {*this};
+}
+
+auto RwLock::try_read() -> Option<ReadGuard> {
+  const auto eid = ::pthread_rwlock_tryrdlock(&_raw);
+  switch (eid) {
+    case 0:
+      return {option::SOME, *this};
+    case EBUSY:
+      return option::NONE;
+    default:
+      throw os::Error{eid};
+  }
+}
+
+auto RwLock::write() -> WriteGuard {
+  const auto eid = ::pthread_rwlock_wrlock(&_raw);
+  if (eid != 0) {
+    throw os::Error{eid};
+  }
+  return {*this};
+}
+
+auto RwLock::try_write() -> Option<WriteGuard> {
+  const auto eid = ::pthread_rwlock_trywrlock(&_raw);
+  switch (eid) {
+    case 0:
+      return {option::SOME, *this};
+    case EBUSY:
+      return option::NONE;
+    default:
+      throw os::Error{eid};
+  }
+}
+
+RwLock::ReadGuard::ReadGuard(RwLock& lock) : _lock{&lock} {}
+
+RwLock::ReadGuard::~ReadGuard() {
+  if (_lock.is_null()) {
+    return;
+  }
+  ::pthread_rwlock_unlock(&_lock->_raw);
+}
+
+RwLock::WriteGuard::WriteGuard(RwLock& lock) : _lock{&lock} {}
+
+RwLock::WriteGuard::~WriteGuard() {
+  if (_lock.is_null()) {
+    return;
+  }
+  ::pthread_rwlock_unlock(&_lock->_raw);
+}
+
 }  // namespace sfc::sync
 
 #endif
@@ -2,6 +2,7 @@
 
 #include "../core.h"
 #include "../time.h"
+#include "atomic.h"
 
 namespace sfc::sync {
 
@@ -12,9 +13,9 @@ struct mtx_t {
 #endif
 
 #ifdef __linux__
-union mtx_t {
-  long _align;
-  char _size[40];
+// 0: unlocked, 1: locked, 2: locked and someone may be sleeping on it.
+struct mtx_t {
+  Atomic<u32> _state;
 };
 #endif
 
@@ -0,0 +1,112 @@
+#include "rwlock.h"
+
+namespace sfc::sync {
+
+#pragma region ShardedRwLock
+static auto _shard_index() -> usize {
+  static auto next = Atomic<u32>{0};
+  static thread_local auto idx = usize(next.fetch_add(1, Ordering::Relaxed)) % ShardedRwLock::SHARDS;
+  return idx;
+}
+
+ShardedRwLock::ShardedRwLock() : _shards{}, _writer{0} {}
+
+ShardedRwLock::~ShardedRwLock() {}
+
+// readers bump their shard and then check `_writer`; a writer sets `_writer`
+// and then checks the shards. with SeqCst on both sides, one of them always
+// sees the other.
+auto ShardedRwLock::read() -> ReadGuard {
+  const auto idx = _shard_index();
+  auto& readers = _shards[idx]._readers;
+  while (true) {
+    readers.fetch_add(1, Ordering::SeqCst);
+    if (_writer.load(Ordering::SeqCst) == 0) {
+      return {*this, idx};
+    }
+    this->_read_unlock(idx);
+
+    auto lock = _mutex.lock();
+    while (_writer.load(Ordering::Relaxed) != 0) {
+      _condvar.wait(lock);
+    }
+  }
+}
+
+auto ShardedRwLock::try_read() -> Option<ReadGuard> {
+  const auto idx = _shard_index();
+  _shards[idx]._readers.fetch_add(1, Ordering::SeqCst);
+  if (_writer.load(Ordering::SeqCst) != 0) {
+    this->_read_unlock(idx);
+    return option::NONE;
+  }
+  return {option::SOME, ReadGuard{*this, idx}};
+}
+
+auto ShardedRwLock::write() -> WriteGuard {
+  auto lock = _mutex.lock();
+  while (_writer.load(Ordering::Relaxed) != 0) {
+    _condvar.wait(lock);
+  }
+
+  _writer.store(1, Ordering::SeqCst);
+  while (!this->_drained()) {
+    _condvar.wait(lock);
+  }
+  return {*this};
+}
+
+auto ShardedRwLock::try_write() -> Option<WriteGuard> {
+  auto lock = _mutex.trylock();
+  if (lock.is_none() || _writer.load(Ordering::Relaxed) != 0) {
+    return option::NONE;
+  }
+
+  _writer.store(1, Ordering::SeqCst);
+  if (!this->_drained()) {
+    _writer.store(0, Ordering::SeqCst);
+    _condvar.notify_all();
+    return option::NONE;
+  }
+  return {option::SOME, *this};
+}
+
+auto ShardedRwLock::_drained() const -> bool {
+  for (usize i = 0; i < SHARDS; ++i) {
+    if (_shards[i]._readers.load(Ordering::SeqCst) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ShardedRwLock::_read_unlock(usize shard) {
+  const auto cnt = _shards[shard]._readers.fetch_sub(1, Ordering::SeqCst);
+  if (cnt == 1 && _writer.load(Ordering::SeqCst) != 0) {
+    auto lock = _mutex.lock();
+    _condvar.notify_all();
+  }
+}
+
+ShardedRwLock::ReadGuard::ReadGuard(ShardedRwLock& lock, usize shard) : _lock{&lock}, _shard{shard} {}
+
+ShardedRwLock::ReadGuard::~ReadGuard() {
+  if (_lock.is_null()) {
+    return;
+  }
+  _lock->_read_unlock(_shard);
+}
+
+ShardedRwLock::WriteGuard::WriteGuard(ShardedRwLock& lock) : _lock{&lock} {}
+
+ShardedRwLock::WriteGuard::~WriteGuard() {
+  if (_lock.is_null()) {
+    return;
+  }
+  auto lock = _lock->_mutex.lock();
+  _lock->_writer.store(0, Ordering::SeqCst);
+  _lock->_condvar.notify_all();
+}
+#pragma endregion
+
+}  // namespace sfc::sync
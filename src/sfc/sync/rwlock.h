@@ -0,0 +1,144 @@
+#pragma once
+
+#include "condvar.h"
+
+namespace sfc::sync {
+
+#ifdef _WIN32
+struct rwl_t {
+  void* _0;
+};
+#endif
+
+#ifdef __linux__
+// reader count in the low bits, plus WRITER, SLEEPER and PARKED_WRITER
+// bits; a parked writer holds back new readers.
+struct rwl_t {
+  Atomic<u32> _state;
+};
+#endif
+
+#ifdef __APPLE__
+struct rwl_t {
+  long _sig;
+  char _opaque[192];
+};
+#endif
+
+struct RwLock {
+  struct ReadGuard;
+  struct WriteGuard;
+  rwl_t _raw;
+
+  RwLock();
+  ~RwLock();
+  RwLock(RwLock&&) = delete;
+  RwLock(const RwLock&) = delete;
+
+  auto read() -> ReadGuard;
+  auto try_read() -> Option<ReadGuard>;
+
+  auto write() -> WriteGuard;
+  auto try_write() -> Option<WriteGuard>;
+};
+
+struct RwLock::ReadGuard {
+  ptr::Unique<RwLock> _lock;
+
+  ReadGuard(RwLock& lock);
+  ~ReadGuard();
+  ReadGuard(ReadGuard&& other) noexcept = default;
+};
+
+struct RwLock::WriteGuard {
+  ptr::Unique<RwLock> _lock;
+
+  WriteGuard(RwLock& lock);
+  ~WriteGuard();
+  WriteGuard(WriteGuard&& other) noexcept = default;
+};
+
+// readers count themselves on one of `SHARDS` cache lines, chosen per
+// thread, so they never write a line another reader's thread uses. a
+// writer raises `_writer`, which holds back new readers, and waits until
+// every shard drains. writers and blocked readers park on `_mutex`.
+struct ShardedRwLock {
+  static constexpr usize SHARDS = 16;
+
+  struct ReadGuard;
+  struct WriteGuard;
+
+  struct alignas(64) Shard {
+    Atomic<u32> _readers;
+  };
+
+  Shard _shards[SHARDS];
+  Atomic<u32> _writer;
+  Mutex _mutex;
+  Condvar _condvar;
+
+  ShardedRwLock();
+  ~ShardedRwLock();
+  ShardedRwLock(ShardedRwLock&&) = delete;
+  ShardedRwLock(const ShardedRwLock&) = delete;
+
+  auto read() -> ReadGuard;
+  auto try_read() -> Option<ReadGuard>;
+
+  auto write() -> WriteGuard;
+  auto try_write() -> Option<WriteGuard>;
+
+  auto _drained() const -> bool;
+  void _read_unlock(usize shard);
+};
+
+struct ShardedRwLock::ReadGuard {
+  ptr::Unique<ShardedRwLock> _lock;
+  usize _shard;
+
+  ReadGuard(ShardedRwLock& lock, usize shard);
+  ~ReadGuard();
+  ReadGuard(ReadGuard&& other) noexcept = default;
+};
+
+struct ShardedRwLock::WriteGuard {
+  ptr::Unique<ShardedRwLock> _lock;
+
+  WriteGuard(ShardedRwLock& lock);
+  ~WriteGuard();
+  WriteGuard(WriteGuard&& other) noexcept = default;
+};
+
+template <class T, class L = RwLock>
+struct XRwLock {
+  T _val;
+  L _lock = {};
+
+  struct ReadGuard {
+    const T& _val;
+    typename L::ReadGuard _guard;
+
+    auto operator->() const -> const T* {
+      return __builtin_addressof(_val);
+    }
+  };
+
+  struct WriteGuard {
+    T& _val;
+    typename L::WriteGuard _guard;
+
+    auto operator->() -> T* {
+      return __builtin_addressof(_val);
+    }
+  };
+
+  auto read() -> ReadGuard {
+    return ReadGuard{._val = _val, ._guard = _lock.read()};
+  }
+
+  auto write() -> WriteGuard {
+    return WriteGuard{._val = _val, ._guard = _lock.write()};
+  }
+};
+
+}  // namespace sfc::sync
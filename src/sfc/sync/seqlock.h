@@ -0,0 +1,50 @@
+#pragma once
+
+#include "futex.h"
+
+namespace sfc::sync {
+
+// a small value that readers copy out without writing anything shared:
+// they retry when a write ran meanwhile. writers take turns on `_seq`,
+// which is odd while a write is in progress.
+template <class T>
+struct SeqLock {
+  static_assert(__is_trivially_copyable(T));
+
+  Atomic<u32> _seq = {0};
+  T _val;
+
+  auto load() const -> T {
+    while (true) {
+      const auto s0 = _seq.load(Ordering::Acquire);
+      if (s0 & 1) {
+        sync::spin_loop();
+        continue;
+      }
+      const auto res = _val;
+      sync::atomic_fence(Ordering::Acquire);
+      if (_seq.load(Ordering::Relaxed) == s0) {
+        return res;
+      }
+    }
+  }
+
+  void store(const T& val) {
+    this->update([&](T& x) { x = val; });
+  }
+
+  // `f(val)` as a single write; `f` should be short, readers spin meanwhile.
+  template <class F>
+  void update(F&& f) {
+    auto s = _seq.load(Ordering::Relaxed);
+    while ((s & 1) || !_seq.compare_exchange(s, s + 1, Ordering::Acquire)) {
+      sync::spin_loop();
+      s = _seq.load(Ordering::Relaxed);
+    }
+    sync::atomic_fence(Ordering::Release);
+    f(_val);
+    _seq.store(s + 2, Ordering::Release);
+  }
+};
+
+}  // namespace sfc::sync
@@ -1,4 +1,6 @@
 #pragma once
 
+#include "test/bench.h"
+#include "test/compare.h"
 #include "test/manager.h"
 #include "test/test.h"
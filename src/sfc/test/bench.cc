@@ -0,0 +1,207 @@
+#include "bench.h"
+
+#include "../fs.h"
+#include "../io/mod-inl.h"
+#include "../serial.h"
+
+namespace sfc::test {
+
+#pragma region Stats
+auto Stats::from_samples(Slice<f64> ns, u64 iters) -> Stats {
+  const auto n = ns.len();
+  if (n == 0) {
+    return Stats{iters, 0, 0, 0, 0, 0, 0, 0, 0};
+  }
+
+  ns.sort_unstable();
+
+  auto sum = 0.0;
+  for (usize i = 0; i < n; ++i) {
+    sum += ns[i];
+  }
+  const auto at = [&](f64 q) { return ns[usize(q * f64(n - 1) + 0.5)]; };
+  return Stats{
+      ._iters = iters,
+      ._samples = n,
+      ._min = ns[0],
+      ._mean = sum / f64(n),
+      ._median = at(0.5),
+      ._p10 = at(0.1),
+      ._p90 = at(0.9),
+      ._p99 = at(0.99),
+      ._max = ns[n - 1],
+  };
+}
+#pragma endregion
+
+#pragma region Bencher
+void Bencher::set_items(u64 n) {
+  _items = n;
+}
+
+void Bencher::set_bytes(u64 n) {
+  _bytes = n;
+}
+
+void Bencher::run_batches(FnMut<u64(u64)> batch) {
+  static constexpr u64 MIN_BATCH_NS = 1000;
+  const auto samples = cmp::max(_opts._samples, usize(1));
+  const auto target = cmp::max(_opts._measure_ns / samples, MIN_BATCH_NS);
+
+  // warm up, doubling the batch until one takes a sample's share of the time.
+  auto n = u64(1);
+  auto last = u64(0);
+  for (auto spent = u64(0); last < target || spent < _opts._warmup_ns; spent += last) {
+    last = batch(n);
+    if (last < target) {
+      n *= 2;
+    }
+  }
+  n = cmp::max(u64(f64(n) * f64(target) / f64(cmp::max(last, u64(1)))), u64(1));
+
+  auto ctr = _opts._perf ? perf::Counter::open_default() : perf::Counter{};
+  auto region = perf::Region{ctr, _counts};
+  _samples.clear();
+  for (usize i = 0; i < samples; ++i) {
+    const auto ns = batch(n);
+    _samples.push(f64(ns) / f64(n));
+    _iters += n;
+  }
+}
+
+auto Bencher::stats() const -> Stats {
+  auto ns = Vec<f64>::with_capacity(_samples.len());
+  for (usize i = 0; i < _samples.len(); ++i) {
+    ns.push(_samples[i]);
+  }
+  return Stats::from_samples(ns.as_mut_slice(), _iters);
+}
+#pragma endregion
+
+auto Bench::from(Str desc, void (*func)(Bencher&)) -> Bench {
+  const auto [mod, name] = test::split_desc(desc, "_bench");
+  return Bench{._mod = mod, ._name = name, ._func = func};
+}
+
+#pragma region BenchResult
+auto BenchResult::items_per_sec() const -> f64 {
+  return _stats._median == 0 ? 0.0 : f64(_items) * 1e9 / _stats._median;
+}
+
+auto BenchResult::bytes_per_sec() const -> f64 {
+  return _stats._median == 0 ? 0.0 : f64(_bytes) * 1e9 / _stats._median;
+}
+
+auto BenchResult::per_iter(perf::Event e) const -> Option<f64> {
+  const auto x = _counts.get(e);
+  if (!x || _stats._iters == 0) {
+    return option::NONE;
+  }
+  return {option::SOME, f64(~x) / f64(_stats._iters)};
+}
+
+static void write_file(Str path, Str text) {
+  auto file = fs::File::create(fs::Path{path});
+  file->write_all(text.as_bytes());
+}
+
+// `fmt` has no escape for braces, so they are written as plain strings.
+void write_json(Str path, Slice<const BenchResult> results) {
+  auto out = String{};
+  const auto field = [&](Str key, const auto& fmt, const auto& val) {
+    out.push_str(*string::format(", \"{}\": ", key));
+    out.push_str(*string::format(fmt, val));
+  };
+
+  out.push_str("[\n");
+  for (usize i = 0; i < results.len(); ++i) {
+    const auto& r = results[i];
+    const auto& s = r._stats;
+    out.push_str("  {\"name\": \"");
+    out.push_str(*r._name);
+    out.push_str("\"");
+    field("iters", "{}", s._iters);
+    field("samples", "{}", s._samples);
+    field("min_ns", "{.3f}", s._min);
+    field("mean_ns", "{.3f}", s._mean);
+    field("median_ns", "{.3f}", s._median);
+    field("p10_ns", "{.3f}", s._p10);
+    field("p90_ns", "{.3f}", s._p90);
+    field("p99_ns", "{.3f}", s._p99);
+    field("max_ns", "{.3f}", s._max);
+    field("items_per_sec", "{.1f}", r.items_per_sec());
+    field("bytes_per_sec", "{.1f}", r.bytes_per_sec());
+    field("items", "{}", r._items);
+    field("bytes", "{}", r._bytes);
+    for (usize k = 0; k < perf::EVENT_COUNT; ++k) {
+      if (const auto x = r.per_iter(perf::Event(k))) {
+        out.push_str(*string::format(", \"{}_per_iter\": {.3f}", perf::event_name(perf::Event(k)), ~x));
+      }
+    }
+    out.push_str(", \"samples_ns\": [");
+    for (usize k = 0; k < r._samples.len(); ++k) {
+      out.push_str(k == 0 ? Str{""} : Str{", "});
+      out.push_str(*string::format("{.3f}", r._samples[k]));
+    }
+    out.push_str(i + 1 == results.len() ? Str{"]}\n"} : Str{"]},\n"});
+  }
+  out.push_str("]\n");
+  write_file(path, *out);
+}
+
+static auto json_int(const serial::Node& node, Str key) -> u64 {
+  const auto x = node.get(key);
+  return x ? u64((~x).as_int().unwrap_or(0)) : 0;
+}
+
+// reads back what `write_json` wrote; entries without samples are skipped.
+auto read_json(Str path) -> Vec<BenchResult> {
+  auto text = String{};
+  auto file = fs::File::open(fs::Path{path});
+  file->read_to_string(text);
+
+  auto res = Vec<BenchResult>{};
+  const auto root = serial::Json::from_str(*text);
+  const auto list = root ? (~root).as_list() : Option<const serial::List&>{};
+  if (!list) {
+    return res;
+  }
+
+  for (usize i = 0; i < (~list).len(); ++i) {
+    const auto& node = (~list)[i];
+    const auto name = node.get("name");
+    const auto samples = node.get("samples_ns");
+    if (!name || !samples || !(~samples).as_list()) {
+      continue;
+    }
+
+    const auto& xs = ~(~samples).as_list();
+    auto ns = Vec<f64>::with_capacity(xs.len());
+    auto tmp = Vec<f64>::with_capacity(xs.len());
+    for (usize k = 0; k < xs.len(); ++k) {
+      ns.push(xs[k].as_flt().unwrap_or(0.0));
+      tmp.push(ns[k]);
+    }
+    const auto stats = Stats::from_samples(tmp.as_mut_slice(), json_int(node, "iters"));
+    res.push(BenchResult{String::from_str((~name).as_str().unwrap_or("")), stats, json_int(node, "items"),
+                         json_int(node, "bytes"), sfc::move(ns)});
+  }
+  return res;
+}
+
+void write_csv(Str path, Slice<const BenchResult> results) {
+  auto out = String{};
+  out.push_str("name,iters,samples,min_ns,mean_ns,median_ns,p10_ns,p90_ns,p99_ns,max_ns,items_per_sec,bytes_per_sec\n");
+  for (usize i = 0; i < results.len(); ++i) {
+    const auto& r = results[i];
+    const auto& s = r._stats;
+    const auto line = string::format("{},{},{},{.3f},{.3f},{.3f},{.3f},{.3f},{.3f},{.3f},{.1f},{.1f}\n", *r._name,
+                                     s._iters, s._samples, s._min, s._mean, s._median, s._p10, s._p90, s._p99,
+                                     s._max, r.items_per_sec(), r.bytes_per_sec());
+    out.push_str(*line);
+  }
+  write_file(path, *out);
+}
+#pragma endregion
+
+}  // namespace sfc::test
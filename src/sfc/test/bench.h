@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../perf.h"
+#include "../time.h"
+#include "test.h"
+
+namespace sfc::test {
+
+// keeps the compiler from assuming anything about `val`: it must be kept
+// in a register or in memory, and may have been read or changed.
+// gcc rejects the register alternative for some types, so it gets memory only.
+template <class T>
+[[gnu::always_inline]] inline void do_not_optimize(T& val) {
+#if defined(__clang__)
+  __asm__ __volatile__("" : "+r,m"(val) : : "memory");
+#else
+  __asm__ __volatile__("" : "+m"(val) : : "memory");
+#endif
+}
+
+template <class T>
+[[gnu::always_inline]] inline void do_not_optimize(const T& val) {
+#if defined(__clang__)
+  __asm__ __volatile__("" : : "r,m"(val) : "memory");
+#else
+  __asm__ __volatile__("" : : "m"(val) : "memory");
+#endif
+}
+
+// returns `val`, which the compiler can no longer see through.
+template <class T>
+[[gnu::always_inline]] inline auto black_box(T val) -> T {
+  test::do_not_optimize(val);
+  return val;
+}
+
+// times per iteration, in ns.
+struct Stats {
+  u64 _iters;
+  usize _samples;
+  f64 _min;
+  f64 _mean;
+  f64 _median;
+  f64 _p10;
+  f64 _p90;
+  f64 _p99;
+  f64 _max;
+
+  static auto from_samples(Slice<f64> ns, u64 iters) -> Stats;
+};
+
+struct BenchOptions {
+  u64 _warmup_ns = 50 * 1000000;
+  u64 _measure_ns = 500 * 1000000;
+  usize _samples = 50;
+  bool _perf = false;  // also count cycles, misses, ... while measuring
+};
+
+struct Bencher {
+  BenchOptions _opts{};
+  u64 _items = 0;  // per iteration
+  u64 _bytes = 0;  // per iteration
+  Vec<f64> _samples{};
+  u64 _iters = 0;
+  perf::Counts _counts{};  // over all `_iters`
+
+  // for the items/s and bytes/s columns.
+  void set_items(u64 n);
+  void set_bytes(u64 n);
+
+  // times `f()`: runs it for the warmup time, picks a batch size that makes
+  // timer overhead negligible, and then times `_samples` batches.
+  template <class F>
+  void iter(F&& f) {
+    auto batch = [&](u64 n) mutable {
+      const auto t0 = time::Instant::now();
+      for (u64 i = 0; i < n; ++i) {
+        if constexpr (__is_same(decltype(f()), void)) {
+          f();
+        } else {
+          test::do_not_optimize(f());
+        }
+      }
+      return t0.elpased().total_nanos();
+    };
+    this->run_batches(batch);
+  }
+
+  void run_batches(FnMut<u64(u64)> batch);
+  auto stats() const -> Stats;
+};
+
+struct Bench {
+  Str _mod;
+  Str _name;
+  void (*_func)(Bencher&);
+
+  static auto from(Str desc, void (*func)(Bencher&)) -> Bench;
+
+  template <class T>
+  static auto from_fn() -> Bench {
+    return Bench::from(__PRETTY_FUNCTION__, [](Bencher& b) { T().run(b); });
+  }
+};
+
+// what one benchmark measured, as written to json and csv.
+struct BenchResult {
+  String _name;
+  Stats _stats;
+  u64 _items;
+  u64 _bytes;
+  Vec<f64> _samples;  // ns per iteration, one per batch
+  perf::Counts _counts = {};
+
+  auto items_per_sec() const -> f64;
+  auto bytes_per_sec() const -> f64;
+
+  // a counter's total divided by the iterations measured.
+  auto per_iter(perf::Event e) const -> Option<f64>;
+};
+
+void write_json(Str path, Slice<const BenchResult> results);
+auto read_json(Str path) -> Vec<BenchResult>;
+void write_csv(Str path, Slice<const BenchResult> results);
+
+}  // namespace sfc::test
+
+#define sfc_bench(func)                                                                          \
+  struct func##_bench {                                                                          \
+    void run(sfc::test::Bencher& b);                                                             \
+  };                                                                                             \
+  auto func##_bench_var = sfc::test::manager().install(sfc::test::Bench::from_fn<func##_bench>()); \
+  void func##_bench::run([[maybe_unused]] sfc::test::Bencher& b)
@@ -0,0 +1,140 @@
+#include "compare.h"
+
+#include "../log.h"
+
+namespace sfc::test {
+
+static constexpr usize BOOTSTRAP_ROUNDS = 1000;
+static constexpr f64 SIGNIFICANCE = 0.05;
+
+// xorshift64*: the resampling only needs to be cheap and repeatable.
+struct Rng {
+  u64 _state;
+
+  auto next_below(usize n) -> usize {
+    _state ^= _state >> 12;
+    _state ^= _state << 25;
+    _state ^= _state >> 27;
+    return usize((_state * 0x2545F4914F6CDD1DULL) >> 32) % n;
+  }
+};
+
+static auto median(Slice<f64> ns) -> f64 {
+  ns.sort_unstable();
+  const auto n = ns.len();
+  return n % 2 == 1 ? ns[n / 2] : (ns[n / 2 - 1] + ns[n / 2]) / 2;
+}
+
+static auto median_of(Slice<const f64> ns) -> f64 {
+  auto tmp = Vec<f64>::with_capacity(ns.len());
+  for (usize i = 0; i < ns.len(); ++i) {
+    tmp.push(ns[i]);
+  }
+  return median(tmp.as_mut_slice());
+}
+
+// resamples both sides with replacement and takes the 2.5% and 97.5%
+// quantiles of the relative change in median.
+static auto bootstrap(Slice<const f64> base, Slice<const f64> cur) -> Tuple<f64, f64> {
+  auto rng = Rng{0x9E3779B97F4A7C15ULL};
+  auto xs = Vec<f64>::with_capacity(base.len());
+  auto ys = Vec<f64>::with_capacity(cur.len());
+  auto changes = Vec<f64>::with_capacity(BOOTSTRAP_ROUNDS);
+
+  for (usize r = 0; r < BOOTSTRAP_ROUNDS; ++r) {
+    xs.clear();
+    ys.clear();
+    for (usize i = 0; i < base.len(); ++i) {
+      xs.push(base[rng.next_below(base.len())]);
+    }
+    for (usize i = 0; i < cur.len(); ++i) {
+      ys.push(cur[rng.next_below(cur.len())]);
+    }
+    const auto mb = median(xs.as_mut_slice());
+    const auto mc = median(ys.as_mut_slice());
+    changes.push(mb == 0 ? 0.0 : mc / mb - 1);
+  }
+
+  auto s = changes.as_mut_slice();
+  s.sort_unstable();
+  const auto at = [&](f64 q) { return s[usize(q * f64(s.len() - 1) + 0.5)]; };
+  return {at(0.025), at(0.975)};
+}
+
+// rank-sum test with the normal approximation; a few dozen samples a side
+// are enough for it, and it does not assume the timings are normal.
+static auto mann_whitney(Slice<const f64> base, Slice<const f64> cur) -> f64 {
+  const auto n1 = f64(base.len());
+  const auto n2 = f64(cur.len());
+
+  auto u = 0.0;
+  for (usize i = 0; i < base.len(); ++i) {
+    for (usize j = 0; j < cur.len(); ++j) {
+      u += base[i] > cur[j] ? 1.0 : base[i] == cur[j] ? 0.5 : 0.0;
+    }
+  }
+
+  const auto mu = n1 * n2 / 2;
+  const auto sigma = __builtin_sqrt(n1 * n2 * (n1 + n2 + 1) / 12);
+  if (sigma == 0) {
+    return 1.0;
+  }
+  const auto z = (u - mu) / sigma;
+  return __builtin_erfc((z < 0 ? -z : z) / __builtin_sqrt(2.0));
+}
+
+auto Delta::is_regression(f64 threshold) const -> bool {
+  return _lo > threshold && _p < SIGNIFICANCE;
+}
+
+auto Delta::is_improvement(f64 threshold) const -> bool {
+  return _hi < -threshold && _p < SIGNIFICANCE;
+}
+
+auto compare(Slice<const BenchResult> base, Slice<const BenchResult> cur) -> Vec<Delta> {
+  auto res = Vec<Delta>{};
+  for (usize i = 0; i < cur.len(); ++i) {
+    const auto& c = cur[i];
+    for (usize j = 0; j < base.len(); ++j) {
+      const auto& b = base[j];
+      if (!(*b._name == *c._name) || b._samples.is_empty() || c._samples.is_empty()) {
+        continue;
+      }
+
+      const auto mb = median_of(b._samples.as_slice());
+      const auto mc = median_of(c._samples.as_slice());
+      const auto [lo, hi] = bootstrap(b._samples.as_slice(), c._samples.as_slice());
+      res.push(Delta{
+          ._name = String::from_str(*c._name),
+          ._base = mb,
+          ._cur = mc,
+          ._change = mb == 0 ? 0.0 : mc / mb - 1,
+          ._lo = lo,
+          ._hi = hi,
+          ._p = mann_whitney(b._samples.as_slice(), c._samples.as_slice()),
+      });
+      break;
+    }
+  }
+  return res;
+}
+
+static auto fmt_pct(f64 x) -> String {
+  return x < 0 ? string::format("{.1f}%", x * 100) : string::format("+{.1f}%", x * 100);
+}
+
+auto report(Slice<const Delta> deltas, f64 threshold) -> usize {
+  auto cnt = usize(0);
+  for (usize i = 0; i < deltas.len(); ++i) {
+    const auto& d = deltas[i];
+    const auto tag = d.is_regression(threshold)    ? Str{"\x1b[31m[--]\x1b[0m"}
+                     : d.is_improvement(threshold) ? Str{"\x1b[32m[++]\x1b[0m"}
+                                                   : Str{"\x1b[36m[==]\x1b[0m"};
+    log::user("{} {<48} {>10.2f} ns -> {>10.2f} ns  {>7} [{}, {}]  p={.3f}", tag, *d._name, d._base, d._cur,
+              *fmt_pct(d._change), *fmt_pct(d._lo), *fmt_pct(d._hi), d._p);
+    cnt += d.is_regression(threshold) ? 1 : 0;
+  }
+  return cnt;
+}
+
+}  // namespace sfc::test
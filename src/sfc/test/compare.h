@@ -0,0 +1,28 @@
+#pragma once
+
+#include "bench.h"
+
+namespace sfc::test {
+
+// one benchmark, baseline against the current run.
+struct Delta {
+  String _name;
+  f64 _base;    // median ns
+  f64 _cur;     // median ns
+  f64 _change;  // cur / base - 1
+  f64 _lo;      // 95% bootstrap interval of `_change`
+  f64 _hi;
+  f64 _p;  // two-sided mann-whitney p-value
+
+  // slower by more than `threshold` (0.05 = 5%), and not by chance.
+  auto is_regression(f64 threshold) const -> bool;
+  auto is_improvement(f64 threshold) const -> bool;
+};
+
+// pairs results up by name; benchmarks missing from either side are left out.
+auto compare(Slice<const BenchResult> base, Slice<const BenchResult> cur) -> Vec<Delta>;
+
+// prints one line per delta, and returns how many regressed.
+auto report(Slice<const Delta> deltas, f64 threshold) -> usize;
+
+}  // namespace sfc::test
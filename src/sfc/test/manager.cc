@@ -1,5 +1,8 @@
 #include "manager.h"
 
+#include "../log.h"
+#include "../thread.h"
+
 namespace sfc::test {
 
 auto Patterns::operator%(Str s) const -> bool {
@@ -25,7 +28,7 @@ auto Patterns::operator%(Str s) const -> bool {
 }
 
 auto Manager::xnew() -> Manager {
-  return Manager{._tests = Vec<Test>::with_capacity(128)};
+  return Manager{._tests = Vec<Test>::with_capacity(128), ._benches = Vec<Bench>::with_capacity(32)};
 }
 
 auto Manager::install(Test test) -> Test& {
@@ -33,12 +36,135 @@ auto Manager::install(Test test) -> Test& {
   return _tests[_tests.len() - 1];
 }
 
-void Manager::run(Patterns pats) {
-  _tests.iter_mut()->for_each([&](Test& f) {
-    if (pats % f._mod) {
-      f();
+auto Manager::install(Bench bench) -> Bench& {
+  _benches.push(bench);
+  return _benches[_benches.len() - 1];
+}
+
+auto Manager::run(Patterns pats, usize jobs) -> usize {
+  static constexpr usize SLOWEST = 10;
+
+  auto tests = Vec<const Test*>{};
+  auto outcomes = Vec<Outcome>{};
+  for (usize i = 0; i < _tests.len(); ++i) {
+    if (pats % _tests[i]._mod) {
+      tests.push(&_tests[i]);
+      outcomes.push(Outcome{false, time::Duration{0, 0}});
+    }
+  }
+
+  // workers take the next test off a shared counter, so a slow test holds
+  // up one worker rather than a fixed share of the list.
+  const auto t0 = time::Instant::now();
+  auto next = sync::Atomic<usize>{0};
+  const auto work = [&] {
+    for (auto i = next.fetch_add(1); i < tests.len(); i = next.fetch_add(1)) {
+      outcomes[i] = (*tests[i])();
+    }
+  };
+  jobs = jobs == 0 ? thread::available_parallelism() : jobs;
+  if (jobs <= 1) {
+    work();
+  } else {
+    thread::scope([&](thread::Scope& s) {
+      for (usize k = 0; k < cmp::min(jobs, tests.len()); ++k) {
+        s.spawn(work);
+      }
+    });
+  }
+  const auto wall = t0.elpased();
+
+  auto order = Vec<usize>::with_capacity(tests.len());
+  auto failed = usize(0);
+  auto total_ns = u64(0);
+  for (usize i = 0; i < tests.len(); ++i) {
+    order.push(i);
+    failed += outcomes[i]._ok ? 0 : 1;
+    total_ns += outcomes[i]._elapsed.total_nanos();
+  }
+  for (usize i = 1; i < order.len(); ++i) {
+    const auto x = order[i];
+    auto j = i;
+    for (; j > 0 && outcomes[order[j - 1]]._elapsed.total_nanos() < outcomes[x]._elapsed.total_nanos(); --j) {
+      order[j] = order[j - 1];
+    }
+    order[j] = x;
+  }
+
+  log::user("\x1b[36m[==]\x1b[0m {} passed, {} failed, {.3f} s wall, {.3f} s in tests, {} jobs", tests.len() - failed,
+            failed, wall.as_secs_f64(), f64(total_ns) / 1e9, jobs);
+  for (usize i = 0; i < cmp::min(order.len(), SLOWEST); ++i) {
+    const auto& t = *tests[order[i]];
+    log::user("\x1b[36m[==]\x1b[0m {>10.3f} ms  {}{}", outcomes[order[i]]._elapsed.as_millis_f64(), t._mod, t._name);
+  }
+  for (usize i = 0; i < tests.len(); ++i) {
+    if (!outcomes[i]._ok) {
+      log::user("\x1b[31m[XX]\x1b[0m {}{}", tests[i]->_mod, tests[i]->_name);
     }
-  });
+  }
+  return failed;
+}
+
+static auto fmt_ns(f64 ns) -> String {
+  if (ns < 1e3) return string::format("{.2f} ns", ns);
+  if (ns < 1e6) return string::format("{.2f} us", ns / 1e3);
+  if (ns < 1e9) return string::format("{.2f} ms", ns / 1e6);
+  return string::format("{.2f} s", ns / 1e9);
+}
+
+static auto fmt_rate(f64 x, Str unit) -> String {
+  if (x < 1e3) return string::format("{.2f} {}/s", x, unit);
+  if (x < 1e6) return string::format("{.2f} K{}/s", x / 1e3, unit);
+  if (x < 1e9) return string::format("{.2f} M{}/s", x / 1e6, unit);
+  return string::format("{.2f} G{}/s", x / 1e9, unit);
+}
+
+static auto fmt_counts(const BenchResult& r) -> String {
+  auto res = String{};
+  for (usize i = 0; i < perf::EVENT_COUNT; ++i) {
+    if (const auto x = r.per_iter(perf::Event(i))) {
+      res.push_str(*string::format("{} {.2f}/it  ", perf::event_name(perf::Event(i)), ~x));
+    }
+  }
+  if (const auto ipc = r._counts.ipc()) {
+    res.push_str(*string::format("ipc {.2f}", ~ipc));
+  }
+  return res;
+}
+
+auto Manager::run_benches(Patterns pats, BenchOptions opts) -> Vec<BenchResult> {
+  auto res = Vec<BenchResult>{};
+  for (usize i = 0; i < _benches.len(); ++i) {
+    const auto& bench = _benches[i];
+    if (!(pats % bench._mod)) {
+      continue;
+    }
+
+    auto b = Bencher{._opts = opts};
+    try {
+      bench._func(b);
+    } catch (...) {
+      log::user("\x1b[31m[bb]\x1b[0m {}{} failed", bench._mod, bench._name);
+      continue;
+    }
+    if (b._samples.is_empty()) {
+      continue;
+    }
+
+    auto r = BenchResult{string::format("{}{}", bench._mod, bench._name), b.stats(), b._items, b._bytes,
+                         sfc::move(b._samples), b._counts};
+    const auto& s = r._stats;
+    const auto rate = r._bytes != 0   ? fmt_rate(r.bytes_per_sec(), "B")
+                      : r._items != 0 ? fmt_rate(r.items_per_sec(), "item")
+                                      : String{};
+    log::user("\x1b[32m[bb]\x1b[0m {<48} median {>10}  p10 {>10}  p90 {>10}  {}", *r._name, *fmt_ns(s._median),
+              *fmt_ns(s._p10), *fmt_ns(s._p90), *rate);
+    if (!r._counts.is_empty()) {
+      log::user("\x1b[32m[bb]\x1b[0m {<48} {}", "", *fmt_counts(r));
+    }
+    res.push(sfc::move(r));
+  }
+  return res;
 }
 
 auto manager() -> Manager& {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bench.h"
 #include "test.h"
 
 namespace sfc::test {
@@ -11,11 +12,18 @@ struct Patterns {
 
 struct Manager {
   Vec<Test> _tests;
+  Vec<Bench> _benches;
 
   static auto xnew() -> Manager;
 
-  void run(Patterns pats);
+  // runs the tests matching `pats` on `jobs` threads (0: one per cpu), then
+  // prints a summary with the slowest ones; returns how many failed.
+  auto run(Patterns pats, usize jobs = 1) -> usize;
   auto install(Test test) -> Test&;
+
+  // runs the benches matching `pats` one after the other, printing each.
+  auto run_benches(Patterns pats, BenchOptions opts) -> Vec<BenchResult>;
+  auto install(Bench bench) -> Bench&;
 };
 
 auto manager() -> Manager&;
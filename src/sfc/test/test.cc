@@ -4,36 +4,58 @@
 
 namespace sfc::test {
 
-auto Test::from(Str desc, void (*func)()) -> Test {
-  // clang, gcc
-  static const auto gnu_prefix = Str("static sfc::test::Test sfc::test::Test::from_fn() [T = ");
+auto split_desc(Str desc, Str suffix) -> Tuple<Str, Str> {
+  // clang: "static sfc::test::Test sfc::test::Test::from_fn() [T = sfc::mod::name_test]"
+  static const auto gnu_prefix = Str("[T = ");
   static const auto gnu_suffix = Str("]");
 
-  // msvc
-  static const auto msvc_prefix = Str("auto sfc::test::Test::from_fn<");
-  static const auto msvc_suffix = Str(">()->sfc::test::Test");
+  // gcc: "static sfc::test::Test sfc::test::Test::from_fn() [with T = sfc::mod::name_test; ...]"
+  static const auto gcc_prefix = Str("[with T = ");
+  static const auto gcc_suffix = Str(";");
 
-  const auto n = desc.len();
+  // msvc: "auto sfc::test::Test::from_fn<sfc::mod::name_test>()->sfc::test::Test"
+  static const auto msvc_prefix = Str("::from_fn<");
+  static const auto msvc_suffix = Str(">()->");
 
   const auto s = [=]() {
-    if (desc.starts_with(gnu_prefix)) return desc[{gnu_prefix.len(), n - gnu_suffix.len()}];
-    if (desc.starts_with(msvc_prefix)) return desc[{msvc_prefix.len(), n - msvc_suffix.len()}];
+    if (auto p = desc.find(gcc_prefix)) {
+      const auto t = desc[{~p + gcc_prefix.len(), desc.len()}];
+      return t[{0, t.find(gcc_suffix).unwrap_or(t.len())}];
+    }
+    if (auto p = desc.find(gnu_prefix); p && desc.ends_with(gnu_suffix)) {
+      return desc[{~p + gnu_prefix.len(), desc.len() - gnu_suffix.len()}];
+    }
+    if (auto p = desc.find(msvc_prefix)) {
+      const auto q = desc.rfind(msvc_suffix).unwrap_or(desc.len());
+      return desc[{~p + msvc_prefix.len(), q}];
+    }
     return desc;
   }();
 
   const auto p = s.rfind(':').map([](usize x) { return x + 1; }).unwrap_or(0);
   const auto [mod, name] = s.split_at(p);
-  return Test{._mod = mod, ._name = name[{0, name.len() - 5}], ._func = func};
+  const auto n = name.ends_with(suffix) ? name.len() - suffix.len() : name.len();
+  return {mod, name[{0, n}]};
+}
+
+auto Test::from(Str desc, void (*func)()) -> Test {
+  const auto [mod, name] = test::split_desc(desc, "_test");
+  return Test{._mod = mod, ._name = name, ._func = func};
 }
 
-void Test::operator()() const {
+auto Test::operator()() const -> Outcome {
+  log::user("\x1b[32m[>>]\x1b[0m {}{} ...", _mod, _name);
+  const auto t0 = time::Instant::now();
   try {
-    log::user("\x1b[32m[>>]\x1b[0m {}{} ...", _mod, _name);
     _func();
-    log::user("\x1b[32m[<<]\x1b[0m {}{} ok", _mod, _name);
   } catch (...) {
-    log::user("\x1b[31m[<<]\x1b[0m {}{} failed", _mod, _name);
+    const auto elapsed = t0.elpased();
+    log::user("\x1b[31m[<<]\x1b[0m {}{} failed ({.3f} ms)", _mod, _name, elapsed.as_millis_f64());
+    return Outcome{false, elapsed};
   }
+  const auto elapsed = t0.elpased();
+  log::user("\x1b[32m[<<]\x1b[0m {}{} ok ({.3f} ms)", _mod, _name, elapsed.as_millis_f64());
+  return Outcome{true, elapsed};
 }
 
 }  // namespace sfc::test
@@ -1,16 +1,28 @@
 #pragma once
 
 #include "../alloc.h"
+#include "../time.h"
 
 namespace sfc::test {
 
+// the module and the name of a test or bench, from the `__PRETTY_FUNCTION__`
+// of its `from_fn`, with `suffix` taken off the name.
+auto split_desc(Str desc, Str suffix) -> Tuple<Str, Str>;
+
+struct Outcome {
+  bool _ok;
+  time::Duration _elapsed;
+};
+
 struct Test {
   Str _mod;
   Str _name;
   void (*_func)();
 
   static auto from(Str desc, void (*func)()) -> Test;
-  void operator()() const;
+
+  // runs and times the test; a panic fails it instead of escaping.
+  auto operator()() const -> Outcome;
 
   template <class T>
   static auto from_fn() -> Test {
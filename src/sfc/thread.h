@@ -1,3 +1,6 @@
 #pragma once
 
+#include "thread/job.h"
+#include "thread/par.h"
+#include "thread/scope.h"
 #include "thread/thread.h"
@@ -1,6 +1,12 @@
 #if defined(__unix__) || defined(__APPLE__)
 
 #include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include "../thread.h"
 
@@ -27,6 +33,7 @@ void Thread::join() {
   if (eid != 0) {
     throw os::Error{eid};
   }
+  _owned = false;
 }
 
 static void* _thread_callback(void* p) {
@@ -45,6 +52,129 @@ auto Thread::xnew(Box<void()> f) -> Thread {
   return Thread{thr, true};
 }
 
+#pragma region Builder
+auto Builder::name(Str name) -> Builder& {
+  _name.clear();
+  _name.push_str(name);
+  return *this;
+}
+
+auto Builder::stack_size(usize size) -> Builder& {
+  _stack_size = size;
+  return *this;
+}
+
+auto Builder::affinity(const CpuSet& cpus) -> Builder& {
+  _cpus = cpus;
+  return *this;
+}
+
+auto Builder::numa_node(u32 node) -> Builder& {
+  _numa_node = i32(node);
+  return *this;
+}
+
+static void _set_name(Str name) {
+  const auto cname = str::FixedCStr<16>{name};
+#if defined(__APPLE__)
+  (void)::pthread_setname_np(cname);
+#else
+  (void)::pthread_setname_np(::pthread_self(), cname);
+#endif
+}
+
+// a preference only: allocations fall back to other nodes when this one
+// is full, and a kernel without numa support just ignores it.
+static void _set_mempolicy(u32 node) {
+#ifdef __linux__
+  static constexpr int MPOL_PREFERRED = 1;
+  u64 mask[CpuSet::MAX / 64] = {};
+  if (node >= CpuSet::MAX) {
+    return;
+  }
+  mask[node / 64] |= u64(1) << (node % 64);
+  (void)::syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, CpuSet::MAX);
+#else
+  (void)node;
+#endif
+}
+
+auto Builder::spawn_fn(Box<void()> f) -> Thread {
+  auto attr = ::pthread_attr_t{};
+  ::pthread_attr_init(&attr);
+
+  auto eid = 0;
+  if (_stack_size != 0) {
+    eid = ::pthread_attr_setstacksize(&attr, cmp::max(_stack_size, usize(PTHREAD_STACK_MIN)));
+  }
+
+#ifdef __linux__
+  auto cpus = _cpus;
+  if (_numa_node >= 0) {
+    const auto node_cpus = Topology::global().node_cpus(u32(_numa_node));
+    const auto both = cpus & node_cpus;
+    cpus = cpus.is_empty() || both.is_empty() ? node_cpus : both;
+  }
+  if (eid == 0 && !cpus.is_empty()) {
+    auto set = ::cpu_set_t{};
+    CPU_ZERO(&set);
+    cpus.for_each([&](usize cpu) { CPU_SET(cpu, &set); });
+    eid = ::pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+  }
+#endif
+
+  // the name and the memory policy can only be set by the thread itself.
+  const auto setup = !_name.is_empty() || _numa_node >= 0;
+  const auto wrap = [&]() {
+    return Box<void()>::xnew([name = String::from_str(*_name), node = _numa_node, f = sfc::move(f)]() mutable {
+      if (!name.is_empty()) {
+        _set_name(*name);
+      }
+      if (node >= 0) {
+        _set_mempolicy(u32(node));
+      }
+      (*f)();
+    });
+  };
+  auto fn = setup ? wrap() : sfc::move(f);
+
+  auto thr = thr_t(0);
+  if (eid == 0) {
+    eid = ::pthread_create(&thr, &attr, _thread_callback, fn.ptr());
+  }
+  ::pthread_attr_destroy(&attr);
+  if (eid != 0) {
+    throw os::Error{eid};
+  }
+  mem::forget(fn);
+  return Thread{thr, true};
+}
+#pragma endregion
+
+auto current_cpu() -> Option<u32> {
+#ifdef __linux__
+  const auto cpu = ::sched_getcpu();
+  if (cpu >= 0) {
+    return {option::SOME, u32(cpu)};
+  }
+#endif
+  return option::NONE;
+}
+
+void set_affinity(const CpuSet& cpus) {
+#ifdef __linux__
+  auto set = ::cpu_set_t{};
+  CPU_ZERO(&set);
+  cpus.for_each([&](usize cpu) { CPU_SET(cpu, &set); });
+  const auto eid = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (eid != 0) {
+    throw os::Error{eid};
+  }
+#else
+  (void)cpus;
+#endif
+}
+
 void yield_now() {
   const auto eid = ::sched_yield();
   if (eid != 0) {
@@ -52,6 +182,11 @@ void yield_now() {
   }
 }
 
+auto available_parallelism() -> usize {
+  const auto cnt = ::sysconf(_SC_NPROCESSORS_ONLN);
+  return cnt > 0 ? usize(cnt) : 1u;
+}
+
 void sleep(time::Duration dur) {
   auto rqtp = ::timespec{
       time_t(dur._secs),
@@ -1,56 +1,171 @@
-#if 0
 #include "job.h"
 
 namespace sfc::thread {
 
-#pragma region JobQueue
-JobQueue::JobQueue() : _mutex{}, _condvar{}, _shutdown{false}, _inn{} {}
+#pragma region Inner
+struct Pool::Inner {
+  Mutex _mutex{};
+  Condvar _condvar{};
+  VecDeque<Job> _jobs{};
+  bool _shutdown = false;
+  Vec<Thread> _threads{};
 
-JobQueue::JobQueue(JobQueue&&) noexcept = default;
+  void push(Job job) {
+    auto lock = _mutex.lock();
+    _jobs.push_back(sfc::move(job));
+    _condvar.notify_one();
+  }
 
-JobQueue::~JobQueue() {}
+  auto pop() -> Option<Job> {
+    auto lock = _mutex.lock();
+    while (_jobs.is_empty() && !_shutdown) {
+      _condvar.wait(lock);
+    }
+    return _jobs.pop_front();
+  }
 
-void JobQueue::push(Job job) {
-  auto lock = _mutex.lock();
-  _inn.push_back(sfc::move(job));
-  _condvar.notify_all();
-}
+  auto try_pop() -> Option<Job> {
+    auto lock = _mutex.lock();
+    return _jobs.pop_front();
+  }
 
-auto JobQueue::pop() -> Option<Job> {
-  auto lock = _mutex.lock();
-  while (_inn.is_empty()) {
-    if (_shutdown.load() == 0)
-    _condvar.wait(lock);
+  void start(usize cnt) {
+    for (usize i = 0; i < cnt; ++i) {
+      auto thr = Thread::xnew(Box<void()>::xnew([this]() mutable {
+        while (auto job = this->pop()) {
+          (~job)();
+        }
+      }));
+      _threads.push(sfc::move(thr));
+    }
   }
-}
 
+  void join() {
+    {
+      auto lock = _mutex.lock();
+      _shutdown = true;
+      _condvar.notify_all();
+    }
+    for (usize i = 0; i < _threads.len(); ++i) {
+      _threads[i].join();
+    }
+  }
+};
 #pragma endregion
 
-#pragma region Pool
+#pragma region Latch
+struct Latch {
+  Mutex _mutex{};
+  Condvar _condvar{};
+  usize _count = 0;
+  bool _failed = false;
+
+  void count_down(bool failed) {
+    auto lock = _mutex.lock();
+    _failed |= failed;
+    _count -= 1;
+    if (_count == 0) {
+      _condvar.notify_all();
+    }
+  }
+
+  auto is_done() -> bool {
+    auto lock = _mutex.lock();
+    return _count == 0;
+  }
 
-static auto _pool_callback(VecDeque<Job>& jobs) {
-  while (true) {
-    if(auto job = jobs.pop()) {
-      (~job)();
+  void wait() {
+    auto lock = _mutex.lock();
+    while (_count != 0) {
+      _condvar.wait(lock);
     }
   }
+};
+
+static auto _run_task(Pool::Task task, const void* ctx, usize idx) -> bool {
+  const auto span = trace::Span{"thread::Pool::task"};
+  try {
+    task(ctx, idx);
+    return false;
+  } catch (...) {
+    return true;
+  }
 }
+#pragma endregion
 
-Pool::Pool(BoxIn inner) noexcept : _inner(sfc::move(inner)) {}
+#pragma region Pool
+Pool::Pool(Box<Inner> inner) noexcept : _inner{sfc::move(inner)} {}
 
 Pool::~Pool() {
   if (_inner.is_null()) {
     return;
   }
   _inner->join();
+  _inner->~Inner();  // Box only releases the memory
 }
 
 Pool::Pool(Pool&&) noexcept = default;
 
 auto Pool::with_num_threads(usize cnt) -> Pool {
-  auto res = Pool{BoxIn::xnew(Inner::xnew())};
+  auto p = alloc::GLOBAL.alloc_one<Inner>();
+  new (ptr::NotNull{p}) Inner{};
+
+  auto res = Pool{Box<Inner>::from_raw(p)};
   res._inner->start(cnt);
   return res;
 }
+
+auto Pool::global() -> Pool& {
+  static auto res = Pool::with_num_threads(thread::available_parallelism() - 1);
+  return res;
+}
+
+auto Pool::num_threads() const -> usize {
+  return _inner->_threads.len();
+}
+
+void Pool::exec(Job job) {
+  if (_inner->_threads.is_empty()) {
+    job();
+    return;
+  }
+  _inner->push(sfc::move(job));
+}
+
+void Pool::_for_each(usize n, Task task, const void* ctx) {
+  if (n == 0) {
+    return;
+  }
+
+  const auto span = trace::Span{"thread::Pool::for_each"};
+  if (n == 1 || _inner->_threads.is_empty()) {
+    for (usize i = 0; i < n; ++i) {
+      task(ctx, i);
+    }
+    return;
+  }
+
+  auto latch = Latch{};
+  latch._count = n;
+  for (usize i = 1; i < n; ++i) {
+    _inner->push(Job::xnew([&latch, task, ctx, i]() mutable { latch.count_down(_run_task(task, ctx, i)); }));
+  }
+  latch.count_down(_run_task(task, ctx, 0));
+
+  // help out instead of blocking: the caller may itself be a pool worker.
+  while (!latch.is_done()) {
+    auto job = _inner->try_pop();
+    if (job.is_none()) {
+      latch.wait();
+      break;
+    }
+    (~job)();
+  }
+
+  if (latch._failed) {
+    panicking::panic("thread::Pool::for_each: task failed");
+  }
+}
+#pragma endregion
+
 }  // namespace sfc::thread
-#endif
@@ -1,20 +1,21 @@
 #pragma once
 
 #include "../collections/vec_deque.h"
+#include "../trace/span.h"
 #include "thread.h"
 
 namespace sfc::thread {
 
-using sync::Atomic;
 using sync::Condvar;
 using sync::Mutex;
 
 using collections::vec_deque::VecDeque;
-#if 0
+
 struct Job {
   Box<void()> _0;
 
   void operator()() {
+    const auto span = trace::Span{"thread::Pool::job"};
     try {
       (*_0)();
     } catch (...) {
@@ -22,25 +23,44 @@ struct Job {
   }
 
   template <class F>
-  static auto xnew(F&& f) -> Job {
-    return Box<void()>::xnew(static_cast<F&&>(f));
+  static auto xnew(F f) -> Job {
+    return Job{Box<void()>::xnew(sfc::move(f))};
   }
 };
 
-struct JobScheduler {
-  Mutex _mutex;
-  Condvar _condvar;
-  Atomic<u32> _shutdown;
-  VecDeque<Job> _inn;
+struct Pool {
+  struct Inner;
+  using Task = void (*)(const void*, usize);
+
+  Box<Inner> _inner;
+
+  explicit Pool(Box<Inner> inner) noexcept;
+  ~Pool();
+  Pool(Pool&&) noexcept;
+
+  static auto with_num_threads(usize cnt) -> Pool;
+
+  // one worker per cpu, minus the caller which joins in `for_each`.
+  static auto global() -> Pool&;
+
+  auto num_threads() const -> usize;
 
-  explicit JobQueue();
-  JobQueue(JobQueue&&) noexcept;
-  ~JobQueue();
+  void exec(Job job);
 
-  void push(Job job);
-  auto pop() -> Option<Job>;
+  template <class F>
+  void exec(F f) {
+    this->exec(Job::xnew(sfc::move(f)));
+  }
+
+  // runs `f(i)` for `i` in `[0, n)`, the calling thread takes `i == 0`
+  // and then helps with queued jobs until all of them are done.
+  template <class F>
+  void for_each(usize n, const F& f) {
+    const auto task = [](const void* p, usize i) { (*static_cast<const F*>(p))(i); };
+    this->_for_each(n, task, &f);
+  }
 
-  auto run() -> usize;
+  void _for_each(usize n, Task task, const void* ctx);
 };
-#endif
+
 }  // namespace sfc::thread
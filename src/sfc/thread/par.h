@@ -0,0 +1,304 @@
+#pragma once
+
+#include "job.h"
+
+namespace sfc::thread {
+
+namespace par {
+
+template <class T>
+struct SliceSource {
+  Slice<T> _inn;
+
+  auto len() const -> usize {
+    return _inn._len;
+  }
+
+  auto operator[](usize idx) const -> T& {
+    return _inn._ptr[idx];
+  }
+};
+
+struct RangeSource {
+  usize _start;
+  usize _len;
+
+  auto len() const -> usize {
+    return _len;
+  }
+
+  auto operator[](usize idx) const -> usize {
+    return _start + idx;
+  }
+};
+
+template <class T>
+auto source(Slice<T> s) -> SliceSource<T> {
+  return {s};
+}
+
+template <class T>
+auto source(Vec<T>& v) -> SliceSource<T> {
+  return {v.as_mut_slice()};
+}
+
+template <class T>
+auto source(const Vec<T>& v) -> SliceSource<const T> {
+  return {v.as_slice()};
+}
+
+inline auto source(ops::Range<usize> r) -> RangeSource {
+  return {r.start, r.len()};
+}
+
+// the number of chunks `len` items are cut into: enough for every worker
+// to take a few, so one slow chunk does not hold up the rest, but never
+// below `min_len` items each. chunks are queued on the global pool, and
+// idle workers take the next one.
+inline auto num_chunks(usize len, usize min_len) -> usize {
+  static constexpr usize CHUNKS_PER_WORKER = 4;
+  const auto workers = Pool::global().num_threads() + 1;
+  const auto max_chunks = len / cmp::max(min_len, usize(1));
+  return cmp::max(cmp::min(max_chunks, workers * CHUNKS_PER_WORKER), usize(1));
+}
+
+// runs `f(chunk, start, end)` for every chunk, in parallel.
+template <class F>
+void for_chunks(usize len, usize chunks, const F& f) {
+  Pool::global().for_each(chunks, [&](usize i) { f(i, len * i / chunks, len * (i + 1) / chunks); });
+}
+
+}  // namespace par
+
+// the parallel loops take a `Slice`, a `Vec` or an `ops::Range<usize>`,
+// and need not be given a grain size; they all run on `Pool::global()`.
+
+// `f(x)` for every item, in no particular order.
+template <class S, class F>
+void par_for_each(S&& xs, const F& f) {
+  const auto src = par::source(xs);
+  const auto chunks = par::num_chunks(src.len(), 1);
+  par::for_chunks(src.len(), chunks, [&](usize, usize start, usize end) {
+    for (auto i = start; i < end; ++i) {
+      f(src[i]);
+    }
+  });
+}
+
+// `f(chunk)` for the consecutive sub-slices of `chunk_size` items, the last
+// may be shorter.
+template <class T, class F>
+void par_chunks(Slice<T> xs, usize chunk_size, const F& f) {
+  const auto size = cmp::max(chunk_size, usize(1));
+  const auto n = (xs.len() + size - 1) / size;
+  par_for_each(ops::Range<usize>{0, n}, [&](usize i) {
+    const auto start = i * size;
+    f(Slice<T>{xs._ptr + start, cmp::min(size, xs.len() - start)});
+  });
+}
+
+template <class T, class F>
+void par_chunks(Vec<T>& xs, usize chunk_size, const F& f) {
+  par_chunks(xs.as_mut_slice(), chunk_size, f);
+}
+
+// `[f(x) for x in xs]`, in the order of `xs`.
+template <class S, class F>
+auto par_map(S&& xs, const F& f) {
+  const auto src = par::source(xs);
+  using U = decltype(f(src[0]));
+
+  const auto len = src.len();
+  auto res = Vec<U>::with_capacity(len);
+  const auto dst = res.as_mut_ptr();
+  par::for_chunks(len, par::num_chunks(len, 1), [&](usize, usize start, usize end) {
+    for (auto i = start; i < end; ++i) {
+      ptr::write(dst + i, f(src[i]));
+    }
+  });
+  res.set_len(len);
+  return res;
+}
+
+// folds every chunk with `f(acc, x)` from a copy of `init`, and then
+// combines the chunks with `reduce(a, b)`, left to right. the chunks only
+// depend on the length and the number of workers, so a non-associative
+// `reduce`, like a float sum, gives the same result for every run.
+template <class S, class A, class F, class R>
+auto par_fold(S&& xs, const A& init, const F& f, const R& reduce) -> A {
+  const auto src = par::source(xs);
+  const auto len = src.len();
+  const auto chunks = par::num_chunks(len, 1);
+
+  auto accs = Vec<A>::with_capacity(chunks);
+  const auto dst = accs.as_mut_ptr();
+  par::for_chunks(len, chunks, [&](usize idx, usize start, usize end) {
+    auto acc = A{init};
+    for (auto i = start; i < end; ++i) {
+      acc = f(sfc::move(acc), src[i]);
+    }
+    ptr::write(dst + idx, sfc::move(acc));
+  });
+  accs.set_len(chunks);
+
+  auto res = sfc::move(accs[0]);
+  for (usize i = 1; i < chunks; ++i) {
+    res = reduce(sfc::move(res), sfc::move(accs[i]));
+  }
+  return res;
+}
+
+// `par_fold` where items and the accumulator have the same type, and
+// `identity` is the neutral element of `op`.
+template <class S, class T, class F>
+auto par_reduce(S&& xs, const T& identity, const F& op) -> T {
+  const auto fold = [&](T acc, const auto& x) { return op(sfc::move(acc), T{x}); };
+  return par_fold(xs, identity, fold, op);
+}
+
+// sorts the chunks on the pool and then merges them pairwise, through a
+// buffer of `len`. every merge is cut into pieces at `co_rank`, so the last
+// rounds, with only a few long runs left, still keep all workers busy.
+// stable. `less` must not panic: the pool would not pass it on.
+template <class T, class F>
+void par_sort_by(Slice<T> xs, const F& less) {
+  static constexpr usize MIN_LEN = 1 << 14;
+
+  const auto n = xs.len();
+  const auto chunks = par::num_chunks(n, MIN_LEN);
+  if (chunks < 2) {
+    xs.sort_by(less);
+    return;
+  }
+  par::for_chunks(n, chunks, [&](usize, usize start, usize end) {
+    slice::sort::stable(xs._ptr + start, end - start, less);
+  });
+
+  auto buf = slice::sort::Buf<T>{n};
+  auto src = xs._ptr;
+  auto dst = buf._ptr;
+  const auto bound = [&](usize run) { return n * cmp::min(run, chunks) / chunks; };
+  for (auto width = usize(1); width < chunks; width *= 2) {
+    const auto pairs = (chunks + 2 * width - 1) / (2 * width);
+    const auto pieces = (chunks + pairs - 1) / pairs;
+    Pool::global().for_each(pairs * pieces, [&](usize idx) {
+      const auto pair = idx / pieces;
+      const auto piece = idx % pieces;
+      const auto lo = bound(2 * width * pair);
+      const auto mid = bound(2 * width * pair + width);
+      const auto hi = bound(2 * width * pair + 2 * width);
+
+      const auto a = src + lo;
+      const auto b = src + mid;
+      const auto k0 = (hi - lo) * piece / pieces;
+      const auto k1 = (hi - lo) * (piece + 1) / pieces;
+      const auto i0 = slice::sort::co_rank(k0, a, mid - lo, b, hi - mid, less);
+      const auto i1 = slice::sort::co_rank(k1, a, mid - lo, b, hi - mid, less);
+      slice::sort::merge_into(a + i0, i1 - i0, b + (k0 - i0), (k1 - i1) - (k0 - i0), dst + lo + k0, less);
+    });
+    mem::swap(src, dst);
+  }
+
+  if (src != xs._ptr) {
+    par::for_chunks(n, chunks, [&](usize, usize start, usize end) { ptr::copy(src + start, xs._ptr + start, end - start); });
+  }
+}
+
+// stable; integer and float keys are radix sorted, every pass split over the
+// pool: each chunk counts its digits, and then scatters its items to where
+// the counts of the chunks before it say they go.
+template <class T, class F>
+void par_sort_by_key(Slice<T> xs, const F& key) {
+  static constexpr usize MIN_LEN = 1 << 14;
+  using K = remove_const_t<remove_ref_t<decltype(key(*xs._ptr))>>;
+
+  const auto n = xs.len();
+  const auto chunks = par::num_chunks(n, MIN_LEN);
+  if constexpr (!slice::sort::is_radix_key<K>()) {
+    thread::par_sort_by(xs, [&](const T& a, const T& b) { return key(a) < key(b); });
+  } else if (chunks < 2) {
+    xs.sort_by_key(key);
+  } else {
+    using U = decltype(slice::sort::radix_bits(key(*xs._ptr)));
+    static constexpr usize PASSES = sizeof(U);
+
+    auto cnts = Vec<usize>::with_capacity(chunks * PASSES * 256);
+    cnts.resize(chunks * PASSES * 256, 0);
+    const auto counts = [&](usize c) { return reinterpret_cast<usize(*)[256]>(&cnts[c * PASSES * 256]); };
+    par::for_chunks(n, chunks, [&](usize c, usize start, usize end) {
+      slice::sort::radix_counts(xs._ptr + start, end - start, key, counts(c));
+    });
+
+    auto buf = slice::sort::Buf<T>{n};
+    auto src = xs._ptr;
+    auto dst = buf._ptr;
+    for (usize p = 0; p < PASSES; ++p) {
+      // the totals tell which passes to skip; the chunks count again every
+      // pass, as the items have moved.
+      usize total[256] = {};
+      for (usize c = 0; c < chunks; ++c) {
+        for (usize d = 0; d < 256; ++d) {
+          total[d] += counts(c)[p][d];
+        }
+      }
+      if (slice::sort::radix_skip(total, n)) {
+        continue;
+      }
+
+      const auto digit = [&](const T& x) { return usize(slice::sort::radix_bits(key(x)) >> (8 * p)) & 0xFF; };
+      auto offs = Vec<usize>::with_capacity(chunks * 256);
+      offs.resize(chunks * 256, 0);
+      par::for_chunks(n, chunks, [&](usize c, usize start, usize end) {
+        const auto cnt = &offs[c * 256];
+        for (auto i = start; i < end; ++i) {
+          cnt[digit(src[i])] += 1;
+        }
+      });
+      for (usize d = 0, sum = 0; d < 256; ++d) {
+        for (usize c = 0; c < chunks; ++c) {
+          const auto cnt = offs[c * 256 + d];
+          offs[c * 256 + d] = sum;
+          sum += cnt;
+        }
+      }
+      par::for_chunks(n, chunks, [&](usize c, usize start, usize end) {
+        const auto off = &offs[c * 256];
+        for (auto i = start; i < end; ++i) {
+          ptr::copy(src + i, dst + off[digit(src[i])]++, 1);
+        }
+      });
+      mem::swap(src, dst);
+    }
+
+    if (src != xs._ptr) {
+      par::for_chunks(n, chunks, [&](usize, usize start, usize end) { ptr::copy(src + start, xs._ptr + start, end - start); });
+    }
+  }
+}
+
+// `Slice::sort`, on the pool.
+template <class T>
+void par_sort(Slice<T> xs) {
+  if constexpr (slice::sort::is_radix_key<T>()) {
+    thread::par_sort_by_key(xs, [](const T& x) { return x; });
+  } else {
+    thread::par_sort_by(xs, slice::sort::Less{});
+  }
+}
+
+template <class T>
+void par_sort(Vec<T>& xs) {
+  thread::par_sort(xs.as_mut_slice());
+}
+
+template <class T, class F>
+void par_sort_by(Vec<T>& xs, const F& less) {
+  thread::par_sort_by(xs.as_mut_slice(), less);
+}
+
+template <class T, class F>
+void par_sort_by_key(Vec<T>& xs, const F& key) {
+  thread::par_sort_by_key(xs.as_mut_slice(), key);
+}
+
+}  // namespace sfc::thread
@@ -0,0 +1,31 @@
+#include "scope.h"
+
+namespace sfc::thread {
+
+void Scope::spawn_fn(Box<void()> f) {
+  auto thr = Thread::xnew(sfc::move(f));
+  auto lock = _mutex.lock();
+  _threads.push(sfc::move(thr));
+}
+
+void Scope::join_all() {
+  while (true) {
+    auto thr = [&] {
+      auto lock = _mutex.lock();
+      return _threads.pop();
+    }();
+    if (thr.is_none()) {
+      break;
+    }
+    (~thr).join();
+  }
+}
+
+void Scope::join() {
+  this->join_all();
+  if (const auto n = _failed.load(sync::Ordering::Relaxed)) {
+    panicking::panic("thread::scope: {} scoped threads failed", n);
+  }
+}
+
+}  // namespace sfc::thread
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "thread.h"
+
+namespace sfc::thread {
+
+// threads spawned on a scope are all joined before `thread::scope` returns,
+// so they may borrow anything that outlives the call, like a `Slice` into
+// the caller's stack:
+//   thread::scope([&](thread::Scope& s) {
+//     s.spawn([&] { left.sort(); });
+//     s.spawn([&] { right.sort(); });
+//   });
+struct Scope {
+  sync::Mutex _mutex{};
+  Vec<Thread> _threads{};
+  sync::Atomic<u32> _failed{0};
+
+  Scope() = default;
+  Scope(const Scope&) = delete;
+
+  // may also be called from the scoped threads themselves.
+  template <class F>
+  void spawn(F f) {
+    this->spawn_fn(Box<void()>::xnew([this, f = sfc::move(f)]() mutable {
+      try {
+        f();
+      } catch (...) {
+        _failed.fetch_add(1, sync::Ordering::Relaxed);
+      }
+    }));
+  }
+
+  void spawn_fn(Box<void()> f);
+
+  // joins every thread, including the ones spawned while joining.
+  void join_all();
+
+  // joins every thread, and panics if any of them failed.
+  void join();
+};
+
+template <class F, class R = decltype(declval<F&>()(declval<Scope&>()))>
+auto scope(F&& f) -> R {
+  auto s = Scope{};
+  try {
+    if constexpr (__is_same(R, void)) {
+      f(s);
+      s.join();
+    } else {
+      auto res = f(s);
+      s.join();
+      return res;
+    }
+  } catch (...) {
+    s.join_all();
+    throw;
+  }
+}
+
+}  // namespace sfc::thread
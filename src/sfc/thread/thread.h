@@ -2,6 +2,7 @@
 
 #include "../os.h"
 #include "../sync.h"
+#include "topology.h"
 
 namespace sfc::thread {
 
@@ -42,23 +43,52 @@ struct JoinHandle {
 template <>
 struct JoinHandle<void>;
 
+// spawns a thread with a name, a stack size, and a place on the machine:
+//   thread::Builder{}.name("io-0").affinity(cpus).spawn([] { ... });
+struct Builder {
+  String _name{};
+  usize _stack_size = 0;
+  CpuSet _cpus{};
+  i32 _numa_node = -1;
+
+  // shows in `top` and debuggers; linux keeps the first 15 bytes.
+  auto name(Str name) -> Builder&;
+
+  auto stack_size(usize size) -> Builder&;
+
+  // runs the thread only on `cpus`, on linux.
+  auto affinity(const CpuSet& cpus) -> Builder&;
+
+  // runs the thread on the cpus of `node`, and has its memory allocated
+  // there first, on linux.
+  auto numa_node(u32 node) -> Builder&;
+
+  auto spawn_fn(Box<void()> f) -> Thread;
+
+  template <class F, class R = ops::invoke_st<F()>>
+  auto spawn(F f) -> JoinHandle<R> {
+    auto res = Arc{Option<R>{option::NONE}};
+    auto fun = Box<void()>::xnew([p = res, f = sfc::move(f)]() mutable {
+      if constexpr (__is_same(R, Nil)) {
+        f();
+        ptr::replace(&*p, {option::SOME, Nil{}});
+      } else {
+        auto x = f();
+        ptr::replace(&*p, {option::SOME, sfc::move(x)});
+      }
+    });
+    auto thr = this->spawn_fn(sfc::move(fun));
+    return {sfc::move(thr), sfc::move(res)};
+  }
+};
+
 template <class F, class R = ops::invoke_st<F()>>
 auto spawn(F f) -> JoinHandle<R> {
-  auto res = Arc{Option<R>{option::NONE}};
-  auto fun = Box<void()>::xnew([p = res, f = sfc::move(f)]() mutable {
-    if constexpr (__is_same(R, Nil)) {
-      f();
-      ptr::replace(&*p, {option::SOME, Nil{}});
-    } else {
-      auto x = f();
-      ptr::replace(&*p, {option::SOME, sfc::move(x)});
-    }
-  });
-  auto thr = Thread::xnew(sfc::move(fun));
-  return {sfc::move(thr), sfc::move(res)};
+  return Builder{}.spawn<F, R>(sfc::move(f));
 }
 
 void sleep(time::Duration dur);
+auto available_parallelism() -> usize;
 void yeild_now();
 
 }  // namespace sfc::thread
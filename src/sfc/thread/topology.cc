@@ -0,0 +1,235 @@
+#include "topology.h"
+
+#include "../fs.h"
+#include "../io/mod-inl.h"
+#include "thread.h"
+
+namespace sfc::thread {
+
+#pragma region CpuSet
+void CpuSet::insert(usize cpu) {
+  if (cpu >= MAX) {
+    return;
+  }
+  _bits[cpu / 64] |= u64(1) << (cpu % 64);
+}
+
+void CpuSet::remove(usize cpu) {
+  if (cpu >= MAX) {
+    return;
+  }
+  _bits[cpu / 64] &= ~(u64(1) << (cpu % 64));
+}
+
+auto CpuSet::contains(usize cpu) const -> bool {
+  return cpu < MAX && (_bits[cpu / 64] >> (cpu % 64)) & 1;
+}
+
+auto CpuSet::count() const -> usize {
+  auto res = usize(0);
+  for (auto w : _bits) {
+    res += usize(__builtin_popcountll(w));
+  }
+  return res;
+}
+
+auto CpuSet::is_empty() const -> bool {
+  return this->count() == 0;
+}
+
+auto CpuSet::operator&(const CpuSet& other) const -> CpuSet {
+  auto res = *this;
+  for (usize i = 0; i < MAX / 64; ++i) {
+    res._bits[i] &= other._bits[i];
+  }
+  return res;
+}
+
+auto CpuSet::operator|(const CpuSet& other) const -> CpuSet {
+  auto res = *this;
+  for (usize i = 0; i < MAX / 64; ++i) {
+    res._bits[i] |= other._bits[i];
+  }
+  return res;
+}
+
+auto CpuSet::from_list(Str s) -> CpuSet {
+  auto res = CpuSet{};
+  auto p = s.as_ptr();
+  const auto end = p + s.len();
+
+  const auto number = [&]() -> Option<usize> {
+    if (p == end || *p < '0' || *p > '9') {
+      return option::NONE;
+    }
+    auto x = usize(0);
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+      x = x * 10 + usize(*p - '0');
+    }
+    return {option::SOME, x};
+  };
+
+  while (p != end) {
+    const auto lo = number();
+    if (!lo) {
+      ++p;
+      continue;
+    }
+    auto hi = ~lo;
+    if (p != end && *p == '-') {
+      ++p;
+      hi = number().unwrap_or(~lo);
+    }
+    for (auto i = ~lo; i <= hi && i < MAX; ++i) {
+      res.insert(i);
+    }
+  }
+  return res;
+}
+#pragma endregion
+
+#pragma region Topology
+#ifdef __linux__
+static auto read_sys(Str path) -> String {
+  auto res = String{};
+  try {
+    auto file = fs::File::open(fs::Path{path});
+    file->read_to_string(res);
+  } catch (...) {
+  }
+  return res;
+}
+
+static auto read_sys_u32(Str path) -> u32 {
+  const auto s = read_sys(path);
+  auto x = u32(0);
+  for (usize i = 0; i < s.len() && s[i] >= '0' && s[i] <= '9'; ++i) {
+    x = x * 10 + u32(s[i] - '0');
+  }
+  return x;
+}
+
+auto Topology::detect() -> Topology {
+  auto online = CpuSet::from_list(*read_sys("/sys/devices/system/cpu/online"));
+  if (online.is_empty()) {
+    for (usize i = 0; i < thread::available_parallelism(); ++i) {
+      online.insert(i);
+    }
+  }
+
+  auto cpus = Vec<Cpu>{};
+  online.for_each([&](usize id) {
+    const auto dir = string::format("/sys/devices/system/cpu/cpu{}/topology/", id);
+    const auto core = read_sys_u32(*string::format("{}core_id", *dir));
+    const auto package = read_sys_u32(*string::format("{}physical_package_id", *dir));
+    cpus.push(Cpu{u32(id), core, package, 0});
+  });
+
+  auto num_nodes = usize(0);
+  const auto nodes = CpuSet::from_list(*read_sys("/sys/devices/system/node/online"));
+  nodes.for_each([&](usize node) {
+    const auto list = read_sys(*string::format("/sys/devices/system/node/node{}/cpulist", node));
+    const auto node_cpus = CpuSet::from_list(*list);
+    for (usize i = 0; i < cpus.len(); ++i) {
+      if (node_cpus.contains(cpus[i]._id)) {
+        cpus[i]._node = u32(node);
+      }
+    }
+    num_nodes = node + 1;
+  });
+
+  // core ids repeat in every package; renumber them densely.
+  auto keys = Vec<u64>{};
+  for (usize i = 0; i < cpus.len(); ++i) {
+    auto& cpu = cpus[i];
+    const auto key = u64(cpu._package) << 32 | cpu._core;
+    auto idx = usize(0);
+    while (idx < keys.len() && keys[idx] != key) {
+      ++idx;
+    }
+    if (idx == keys.len()) {
+      keys.push(key);
+    }
+    cpu._core = u32(idx);
+  }
+
+  const auto num_cores = keys.len();
+  return Topology{sfc::move(cpus), num_cores, num_nodes == 0 ? 1 : num_nodes};
+}
+#else
+auto Topology::detect() -> Topology {
+  const auto n = thread::available_parallelism();
+  auto cpus = Vec<Cpu>::with_capacity(n);
+  for (usize i = 0; i < n; ++i) {
+    cpus.push(Cpu{u32(i), u32(i), 0, 0});
+  }
+  return Topology{sfc::move(cpus), n, 1};
+}
+#endif
+
+auto Topology::global() -> const Topology& {
+  static const auto res = Topology::detect();
+  return res;
+}
+
+auto Topology::cpus() const -> Slice<const Cpu> {
+  return _cpus.as_slice();
+}
+
+auto Topology::num_cpus() const -> usize {
+  return _cpus.len();
+}
+
+auto Topology::num_cores() const -> usize {
+  return _num_cores;
+}
+
+auto Topology::num_nodes() const -> usize {
+  return _num_nodes;
+}
+
+auto Topology::node_cpus(u32 node) const -> CpuSet {
+  auto res = CpuSet{};
+  for (usize i = 0; i < _cpus.len(); ++i) {
+    const auto& cpu = _cpus[i];
+    if (cpu._node == node) {
+      res.insert(cpu._id);
+    }
+  }
+  return res;
+}
+
+auto Topology::siblings(u32 id) const -> CpuSet {
+  auto res = CpuSet{};
+  for (usize i = 0; i < _cpus.len(); ++i) {
+    if (_cpus[i]._id != id) {
+      continue;
+    }
+    for (usize j = 0; j < _cpus.len(); ++j) {
+      if (_cpus[j]._core == _cpus[i]._core) {
+        res.insert(_cpus[j]._id);
+      }
+    }
+    break;
+  }
+  return res;
+}
+
+auto Topology::primary_cpus() const -> CpuSet {
+  auto res = CpuSet{};
+  auto seen = Vec<bool>{};
+  for (usize i = 0; i < _num_cores; ++i) {
+    seen.push(false);
+  }
+  for (usize i = 0; i < _cpus.len(); ++i) {
+    const auto& cpu = _cpus[i];
+    if (!seen[cpu._core]) {
+      seen[cpu._core] = true;
+      res.insert(cpu._id);
+    }
+  }
+  return res;
+}
+#pragma endregion
+
+}  // namespace sfc::thread
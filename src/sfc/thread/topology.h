@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../alloc.h"
+
+namespace sfc::thread {
+
+// a set of logical cpus, as wide as the kernel's `cpu_set_t`.
+struct CpuSet {
+  static constexpr usize MAX = 1024;
+
+  u64 _bits[MAX / 64] = {};
+
+  // parses the kernel's list format, like "0-3,8,10-11".
+  static auto from_list(Str s) -> CpuSet;
+
+  void insert(usize cpu);
+  void remove(usize cpu);
+  auto contains(usize cpu) const -> bool;
+  auto count() const -> usize;
+  auto is_empty() const -> bool;
+
+  auto operator&(const CpuSet& other) const -> CpuSet;
+  auto operator|(const CpuSet& other) const -> CpuSet;
+
+  template <class F>
+  void for_each(F&& f) const {
+    for (usize i = 0; i < MAX / 64; ++i) {
+      for (auto w = _bits[i]; w != 0; w &= w - 1) {
+        f(i * 64 + usize(__builtin_ctzll(w)));
+      }
+    }
+  }
+};
+
+struct Cpu {
+  u32 _id;
+  u32 _core;     // unique over the packages
+  u32 _package;
+  u32 _node;
+};
+
+// what the machine looks like, from `/sys` on linux. elsewhere every cpu
+// is taken as a core of its own, on a single node.
+struct Topology {
+  Vec<Cpu> _cpus;
+  usize _num_cores;
+  usize _num_nodes;
+
+  static auto detect() -> Topology;
+
+  // detected once, at the first call.
+  static auto global() -> const Topology&;
+
+  auto cpus() const -> Slice<const Cpu>;
+  auto num_cpus() const -> usize;
+  auto num_cores() const -> usize;
+  auto num_nodes() const -> usize;
+
+  auto node_cpus(u32 node) const -> CpuSet;
+
+  // the cpus sharing a core with `cpu`, `cpu` included.
+  auto siblings(u32 cpu) const -> CpuSet;
+
+  // one cpu per core: threads pinned to these never share a core.
+  auto primary_cpus() const -> CpuSet;
+};
+
+// the cpu the calling thread is running on, if the os tells.
+auto current_cpu() -> Option<u32>;
+
+// pins the calling thread; throws `os::Error` if no cpu of `cpus` is usable.
+void set_affinity(const CpuSet& cpus);
+
+}  // namespace sfc::thread
@@ -3,3 +3,4 @@
 #include "time/duration.h"
 #include "time/instant.h"
 #include "time/system.h"
+#include "time/tsc.h"
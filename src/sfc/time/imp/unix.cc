@@ -9,9 +9,25 @@
 
 namespace sfc::time {
 
+// the coarse clocks return the time of the last tick, a few ms old, but
+// cost about as much as reading a variable.
+#ifdef CLOCK_MONOTONIC_COARSE
+static constexpr auto CLOCK_MONOTONIC_FAST = CLOCK_MONOTONIC_COARSE;
+static constexpr auto CLOCK_REALTIME_FAST = CLOCK_REALTIME_COARSE;
+#else
+static constexpr auto CLOCK_MONOTONIC_FAST = CLOCK_MONOTONIC;
+static constexpr auto CLOCK_REALTIME_FAST = CLOCK_REALTIME;
+#endif
+
 auto Instant::now() -> Instant {
   auto res = ::timespec{};
-  (void)::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &res);
+  (void)::clock_gettime(CLOCK_MONOTONIC, &res);
+  return Instant{u64(res.tv_sec), u32(res.tv_nsec)};
+}
+
+auto Instant::now_coarse() -> Instant {
+  auto res = ::timespec{};
+  (void)::clock_gettime(CLOCK_MONOTONIC_FAST, &res);
   return Instant{u64(res.tv_sec), u32(res.tv_nsec)};
 }
 
@@ -21,6 +37,12 @@ auto System::now() -> System {
   return System{u64(res.tv_sec), u32(res.tv_nsec)};
 }
 
+auto System::now_coarse() -> System {
+  auto res = ::timespec{};
+  (void)::clock_gettime(CLOCK_REALTIME_FAST, &res);
+  return System{u64(res.tv_sec), u32(res.tv_nsec)};
+}
+
 }  // namespace sfc::time
 
 #endif
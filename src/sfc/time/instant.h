@@ -4,11 +4,16 @@
 
 namespace sfc::time {
 
+// a point on the monotonic clock, which never jumps and keeps running
+// while the process sleeps.
 struct Instant {
   u64 _secs;
   u32 _nanos;
 
   static auto now() -> Instant;
+
+  // up to a few ms behind `now`, but much cheaper to read.
+  static auto now_coarse() -> Instant;
   static auto from_nanos(u64 nanos) -> Instant;
 
   auto total_nanos() const -> u64;
@@ -9,6 +9,9 @@ struct System {
   u32 _nanos;
 
   static auto now() -> System;
+
+  // up to a few ms behind `now`, but much cheaper to read.
+  static auto now_coarse() -> System;
   static auto from_nanos(u64 nanos) -> System;
 
   auto total_nanos() const -> u64;
@@ -0,0 +1,76 @@
+#include "tsc.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace sfc::time {
+
+struct TscCalib {
+  f64 _per_sec;
+  u64 _mult;  // ns = ticks * _mult >> 32
+
+  static auto from_per_sec(f64 per_sec) -> TscCalib {
+    const auto mult = f64(NANOS_PER_SEC) / per_sec * f64(u64(1) << 32);
+    return TscCalib{per_sec, u64(mult)};
+  }
+};
+
+// x86 does not say how fast the counter runs, so it is timed against the
+// monotonic clock for 10ms, once.
+static auto calibrate() -> TscCalib {
+#if defined(__x86_64__) || defined(__i386__)
+  static constexpr u64 SPAN_NS = 10 * NANOS_PER_MILLI;
+  const auto t0 = Instant::now();
+  const auto c0 = Tsc::ticks_ordered();
+  auto t1 = t0;
+  while (t1.duration_since(t0).total_nanos() < SPAN_NS) {
+    t1 = Instant::now();
+  }
+  const auto c1 = Tsc::ticks_ordered();
+  return TscCalib::from_per_sec(f64(c1 - c0) / t1.duration_since(t0).as_secs_f64());
+#elif defined(__aarch64__)
+  u64 freq;
+  __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+  return TscCalib::from_per_sec(f64(freq));
+#else
+  return TscCalib::from_per_sec(f64(NANOS_PER_SEC));
+#endif
+}
+
+static auto calib() -> const TscCalib& {
+  static const auto res = calibrate();
+  return res;
+}
+
+auto Tsc::is_invariant() -> bool {
+#if defined(__x86_64__) || defined(__i386__)
+  u32 eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (edx >> 8) & 1;
+#else
+  return true;
+#endif
+}
+
+auto Tsc::ticks_per_sec() -> f64 {
+  return calib()._per_sec;
+}
+
+auto Tsc::to_nanos(u64 ticks) -> u64 {
+  using u128 = unsigned __int128;
+  return u64((u128(ticks) * calib()._mult) >> 32);
+}
+
+auto FastInstant::duration_since(FastInstant earlier) const -> Duration {
+  const auto ticks = _ticks > earlier._ticks ? _ticks - earlier._ticks : 0;
+  return Duration::from_nanos(Tsc::to_nanos(ticks));
+}
+
+auto FastInstant::elapsed() const -> Duration {
+  return FastInstant::now().duration_since(*this);
+}
+
+}  // namespace sfc::time
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "instant.h"
+
+namespace sfc::time {
+
+// the cpu's own cycle counter: reading it takes a few ns and never enters
+// the kernel. on x86 this is `rdtsc`, which ticks at a fixed rate on every
+// cpu since about 2008 (see `is_invariant`); on arm64 it is the generic
+// timer. elsewhere it falls back to the monotonic clock, in ns.
+struct Tsc {
+  // the counter, not ordered with the loads and stores around it.
+  [[gnu::always_inline]] static auto ticks() -> u64 {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    u64 res;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(res));
+    return res;
+#else
+    return Instant::now().total_nanos();
+#endif
+  }
+
+  // the counter, read only after every earlier instruction has finished.
+  [[gnu::always_inline]] static auto ticks_ordered() -> u64 {
+#if defined(__x86_64__) || defined(__i386__)
+    u32 aux;
+    return __builtin_ia32_rdtscp(&aux);
+#elif defined(__aarch64__)
+    u64 res;
+    __asm__ __volatile__("isb; mrs %0, cntvct_el0" : "=r"(res)::"memory");
+    return res;
+#else
+    return Instant::now().total_nanos();
+#endif
+  }
+
+  // whether the counter ticks at a fixed rate, through frequency changes
+  // and sleep states, and in step on every cpu.
+  static auto is_invariant() -> bool;
+
+  // the rate, calibrated against the monotonic clock on first use.
+  static auto ticks_per_sec() -> f64;
+
+  static auto to_nanos(u64 ticks) -> u64;
+};
+
+// an `Instant` read from `Tsc`: for timing the stages of a request, where
+// a clock read must cost less than the work being timed.
+struct FastInstant {
+  u64 _ticks;
+
+  [[gnu::always_inline]] static auto now() -> FastInstant {
+    return FastInstant{Tsc::ticks()};
+  }
+
+  auto duration_since(FastInstant earlier) const -> Duration;
+  auto elapsed() const -> Duration;
+};
+
+}  // namespace sfc::time
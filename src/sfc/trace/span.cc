@@ -0,0 +1,187 @@
+#include "span.h"
+
+#include "../fs.h"
+#include "../io/mod-inl.h"
+#include "../sync/mutex.h"
+
+namespace sfc::trace {
+
+// per thread; at 32 bytes a record this is 512K.
+static constexpr u64 RING_LEN = 1 << 14;
+
+struct Record {
+  const u8* _name;
+  u64 _len;
+  u64 _begin;
+  u64 _end;
+};
+
+// written by one thread at a time; read by `collect` on any thread.
+struct Buffer {
+  Record* _ring;
+  sync::Atomic<u64> _head;  // records ever written
+  u64 _taken;         // records already collected, under the global lock
+  u32 _tid;
+  bool _dead;         // its thread has exited, under the global lock
+
+  void push(Str name, u64 begin, u64 end) {
+    const auto idx = _head.load(sync::Ordering::Relaxed);
+    auto& r = _ring[idx & (RING_LEN - 1)];
+    __atomic_store_n(&r._name, name.as_ptr(), __ATOMIC_RELAXED);
+    __atomic_store_n(&r._len, u64(name.len()), __ATOMIC_RELAXED);
+    __atomic_store_n(&r._begin, begin, __ATOMIC_RELAXED);
+    __atomic_store_n(&r._end, end, __ATOMIC_RELAXED);
+    _head.store(idx + 1, sync::Ordering::Release);
+  }
+};
+
+// buffers are never freed: one left by an exiting thread keeps its spans
+// until collected, and is then handed to the next new thread.
+struct Global {
+  sync::Mutex _mutex{};
+  Vec<Buffer*> _buffers{};
+  Vec<Buffer*> _free{};
+  u32 _next_tid = 1;
+  u64 _origin = time::Tsc::ticks();
+
+  static auto instance() -> Global& {
+    static auto res = Global{};
+    return res;
+  }
+
+  auto acquire() -> Buffer* {
+    auto lock = _mutex.lock();
+    if (auto buf = _free.pop()) {
+      (~buf)->_tid = _next_tid++;
+      return ~buf;
+    }
+    const auto buf = alloc::GLOBAL.alloc_one<Buffer>();
+    const auto ring = alloc::GLOBAL.alloc_array<Record>(RING_LEN);
+    ptr::write(buf, Buffer{ring, {0}, 0, _next_tid++, false});
+    _buffers.push(buf);
+    return buf;
+  }
+
+  // a buffer still holding spans is reused only once `collect` drains it.
+  void release(Buffer* buf) {
+    auto lock = _mutex.lock();
+    if (buf->_taken == buf->_head.load(sync::Ordering::Relaxed)) {
+      _free.push(buf);
+    } else {
+      buf->_dead = true;
+    }
+  }
+};
+
+struct Handle {
+  Buffer* _buf = nullptr;
+
+  ~Handle() {
+    if (_buf != nullptr) {
+      Global::instance().release(_buf);
+    }
+  }
+
+  auto buf() -> Buffer* {
+    if (_buf == nullptr) {
+      _buf = Global::instance().acquire();
+    }
+    return _buf;
+  }
+};
+
+static auto _buffer() -> Buffer* {
+  static thread_local auto handle = Handle{};
+  return handle.buf();
+}
+
+void enable() {
+  (void)Global::instance();  // fixes the origin
+  _enabled.store(1, sync::Ordering::Relaxed);
+}
+
+void disable() {
+  _enabled.store(0, sync::Ordering::Relaxed);
+}
+
+void record(Str name, u64 begin, u64 end) {
+  _buffer()->push(name, begin, end);
+}
+
+auto collect() -> Vec<Event> {
+  auto& g = Global::instance();
+  auto lock = g._mutex.lock();
+
+  auto res = Vec<Event>{};
+  for (usize i = 0; i < g._buffers.len(); ++i) {
+    auto& buf = *g._buffers[i];
+    const auto head = buf._head.load(sync::Ordering::Acquire);
+    const auto from = head > RING_LEN && head - RING_LEN > buf._taken ? head - RING_LEN : buf._taken;
+    const auto tid = buf._tid;
+
+    const auto start = res.len();
+    for (auto idx = from; idx < head; ++idx) {
+      const auto& r = buf._ring[idx & (RING_LEN - 1)];
+      const auto ptr = __atomic_load_n(&r._name, __ATOMIC_RELAXED);
+      const auto len = __atomic_load_n(&r._len, __ATOMIC_RELAXED);
+      const auto begin = __atomic_load_n(&r._begin, __ATOMIC_RELAXED);
+      const auto end = __atomic_load_n(&r._end, __ATOMIC_RELAXED);
+      const auto t0 = begin > g._origin ? time::Tsc::to_nanos(begin - g._origin) : 0;
+      const auto dur = end > begin ? time::Tsc::to_nanos(end - begin) : 0;
+      res.push(Event{Str{ptr, usize(len)}, tid, t0, dur});
+    }
+
+    // records the owner wrote over while they were being copied are torn,
+    // and so may be record `now - RING_LEN`, whose slot `now` is written to.
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    const auto now = buf._head.load(sync::Ordering::Relaxed);
+    if (now + 1 > RING_LEN && now + 1 - RING_LEN > from) {
+      const auto lost = cmp::min(usize(now + 1 - RING_LEN - from), res.len() - start);
+      for (usize k = start; k + lost < res.len(); ++k) {
+        res[k] = res[k + lost];
+      }
+      res.truncate(res.len() - lost);
+    }
+    buf._taken = head;
+    if (buf._dead) {
+      buf._dead = false;
+      g._free.push(&buf);
+    }
+  }
+  return res;
+}
+
+static void push_escaped(String& out, Str s) {
+  for (usize i = 0; i < s.len(); ++i) {
+    const auto c = char(s[i]);
+    if (c == '"' || c == '\\') {
+      out.push(u8('\\'));
+    }
+    out.push(u8(c));
+  }
+}
+
+// "X" events carry their own duration, so a span is one record.
+auto to_json(Slice<const Event> events) -> String {
+  auto out = String{};
+  out.push_str("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+  for (usize i = 0; i < events.len(); ++i) {
+    const auto& e = events[i];
+    out.push_str("  {\"name\": \"");
+    push_escaped(out, e._name);
+    out.push_str(*string::format("\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {.3f}, \"dur\": {.3f}", e._tid,
+                                 f64(e._begin) / 1e3, f64(e._dur) / 1e3));
+    out.push_str(i + 1 == events.len() ? Str{"}\n"} : Str{"},\n"});
+  }
+  out.push_str("]}\n");
+  return out;
+}
+
+void flush(Str path) {
+  const auto events = trace::collect();
+  const auto text = trace::to_json(events.as_slice());
+  auto file = fs::File::create(fs::Path{path});
+  file->write_all((*text).as_bytes());
+}
+
+}  // namespace sfc::trace
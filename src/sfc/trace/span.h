@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../sync/atomic.h"
+#include "../time/tsc.h"
+
+// building with -DSFC_NO_TRACE turns every span into an empty struct.
+#if !defined(SFC_NO_TRACE)
+#define SFC_TRACE 1
+#else
+#define SFC_TRACE 0
+#endif
+
+namespace sfc::trace {
+
+// spans cost a relaxed load until tracing is switched on.
+inline sync::Atomic<u32> _enabled{0};
+
+inline auto is_enabled() -> bool {
+  return SFC_TRACE && _enabled.load(sync::Ordering::Relaxed) != 0;
+}
+
+void enable();
+void disable();
+
+// appends a finished span to the calling thread's buffer; `name` is kept
+// by pointer, so it should be a literal.
+void record(Str name, u64 begin, u64 end);
+
+// times the scope it lives in, on the tsc:
+//   const auto _span = trace::Span{"json::parse"};
+// each thread keeps its latest spans in its own ring, which only that
+// thread writes to, so recording takes no lock and does not log anything.
+struct Span {
+#if SFC_TRACE
+  Str _name;
+  u64 _begin;
+
+  explicit Span(Str name) : _name{name}, _begin{trace::is_enabled() ? time::Tsc::ticks() : 0} {}
+
+  ~Span() {
+    if (_begin != 0) {
+      trace::record(_name, _begin, time::Tsc::ticks());
+    }
+  }
+#else
+  explicit Span(Str) {}
+#endif
+
+  Span(const Span&) = delete;
+};
+
+// a span, as taken out of the buffers; times are in ns since the first span.
+struct Event {
+  Str _name;
+  u32 _tid;
+  u64 _begin;
+  u64 _dur;
+};
+
+// takes the spans recorded since the last call, from every thread. a thread
+// that wraps its ring while this runs loses the spans it wrote over.
+auto collect() -> Vec<Event>;
+
+// the spans as chrome trace-event json, which perfetto and chrome://tracing
+// both open.
+auto to_json(Slice<const Event> events) -> String;
+
+// collects, and writes the json to `path`.
+void flush(Str path);
+
+}  // namespace sfc::trace
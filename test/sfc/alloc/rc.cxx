@@ -0,0 +1,46 @@
+#include "sfc/alloc.h"
+#include "sfc/test.h"
+
+namespace sfc::rc {
+
+struct Counted {
+  i32* _live;
+  u32 _val;
+
+  Counted(i32* live, u32 val) : _live{live}, _val{val} {
+    *_live += 1;
+  }
+
+  Counted(const Counted& other) : _live{other._live}, _val{other._val} {
+    *_live += 1;
+  }
+
+  ~Counted() {
+    *_live -= 1;
+  }
+};
+
+sfc_test(rc) {
+  auto live = 0;
+  {
+    auto a = Rc{Counted{&live, 1}};
+    assert_eq(live, 1);
+
+    auto b = a;
+    assert_eq(a.strong_count(), 2u);
+
+    b.make_mut()._val = 2;
+    assert_eq(a->_val, 1u);
+    assert_eq(b->_val, 2u);
+    assert_eq(a.strong_count(), 1u);
+    assert_eq(live, 2);
+
+    // not shared any more: no clone.
+    b.make_mut()._val = 3;
+    assert_eq(b->_val, 3u);
+    assert_eq(live, 2);
+  }
+  assert_eq(live, 0);
+}
+
+}  // namespace sfc::rc
@@ -0,0 +1,57 @@
+#include "sfc/alloc.h"
+#include "sfc/test.h"
+
+namespace sfc::alloc::stats {
+
+sfc_test(size_class) {
+  assert_eq(size_class(0), 0u);
+  assert_eq(size_class(1), 0u);
+  assert_eq(size_class(2), 1u);
+  assert_eq(size_class(3), 2u);
+  assert_eq(size_class(4), 2u);
+  assert_eq(size_class(5), 3u);
+  assert_eq(size_class(4096), 12u);
+  assert_eq(size_class(4097), 13u);
+  assert_eq(size_class(usize(1) << 40), CLASS_COUNT - 1);
+}
+
+// other tests may allocate at the same time, so the counts are lower bounds.
+sfc_test(profile) {
+  struct Blob {
+    u64 _x[5];
+  };
+
+  stats::enable(1);
+  const auto s0 = stats::summary();
+  {
+    auto v = Vec<u64>{};
+    for (auto i = 0u; i < 1000; ++i) {
+      v.push(i);
+    }
+    auto blobs = Vec<Box<Blob>>::with_capacity(100);
+    for (auto i = 0u; i < 100; ++i) {
+      blobs.push(Box<Blob>{Blob{{i}}});
+    }
+  }
+  const auto d = stats::summary() - s0;
+
+  const auto& c = d._classes[size_class(sizeof(Blob))];
+  assert(c._allocs >= 100 && c._frees >= 100, "profile: boxes by size class");
+  assert(c._bytes >= 100 * sizeof(Blob), "profile: bytes by size class");
+  assert(d._reallocs >= 3, "profile: vec growth reallocates");
+  assert(d._bytes >= 1000 * sizeof(u64) + 100 * sizeof(Blob), "profile: bytes requested");
+  assert(d._peak > 0, "profile: peak");
+
+  const auto xs = stats::samples();
+  assert(!xs.is_empty(), "profile: stacks sampled");
+  assert(!xs[0]._frames.is_empty() && xs[0]._count > 0, "profile: stack");
+  assert(!stats::symbol(xs[0]._frames[0]).is_empty(), "profile: symbol");
+  for (usize i = 1; i < xs.len(); ++i) {
+    assert(xs[i - 1]._bytes >= xs[i]._bytes, "profile: samples by bytes");
+  }
+
+  stats::report(1);
+  stats::disable();
+}
+
+}  // namespace sfc::alloc::stats
@@ -0,0 +1,42 @@
+#include "sfc/alloc.h"
+#include "sfc/test.h"
+
+namespace sfc::vec {
+
+sfc_test(swap_remove) {
+  auto v = Vec<u32>{};
+  for (auto i = 0u; i < 4; ++i) {
+    v.push(i);
+  }
+  assert_eq(v.swap_remove(1), 1u);
+  assert_eq(v[1], 3u);
+  assert_eq(v.swap_remove(2), 2u);
+  assert_eq(v.len(), 2u);
+}
+
+// growth from empty: the cost of reallocating and moving as the vec doubles.
+sfc_bench(push_grow) {
+  static constexpr u32 N = 4096;
+  b.set_items(N);
+  b.iter([] {
+    auto v = Vec<u32>{};
+    for (auto i = 0u; i < N; ++i) {
+      v.push(i);
+    }
+    return v.len();
+  });
+}
+
+sfc_bench(push_reserved) {
+  static constexpr u32 N = 4096;
+  b.set_items(N);
+  b.iter([] {
+    auto v = Vec<u32>::with_capacity(N);
+    for (auto i = 0u; i < N; ++i) {
+      v.push(i);
+    }
+    return v.len();
+  });
+}
+
+}  // namespace sfc::vec
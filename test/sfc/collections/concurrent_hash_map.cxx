@@ -0,0 +1,82 @@
+#include "sfc/collections/concurrent_hash_map.h"
+
+#include "sfc/test.h"
+#include "sfc/thread.h"
+
+namespace sfc::collections::concurrent_hash_map {
+
+sfc_test(string_keys) {
+  auto map = ConcurrentHashMap<String, u32>{};
+  assert(map.insert(String::from_str("a"), 1), "insert: new key");
+  assert(map.insert(String::from_str("b"), 2), "insert: new key");
+  assert(!map.insert(String::from_str("a"), 3), "insert: replaces");
+  assert_eq(map.len(), 2u);
+
+  assert_eq(hash::hash(Str{"a"}), hash::hash(String::from_str("a")));
+  assert_eq(~map.get(Str{"a"}), 3u);
+  assert_eq(~map.get(Str{"b"}), 2u);
+  assert(map.get(Str{"c"}).is_none(), "get: missing key");
+
+  assert(map.remove(Str{"a"}), "remove: present");
+  assert(!map.remove(Str{"a"}), "remove: already gone");
+  assert(!map.contains_key(Str{"a"}), "contains_key: removed");
+  assert_eq(map.len(), 1u);
+}
+
+sfc_test(grow) {
+  auto map = ConcurrentHashMap<u64, u64>{};
+  for (auto i = 0u; i < 10000; ++i) {
+    map.insert(i, i * i);
+  }
+  for (auto i = 0u; i < 10000; i += 2) {
+    map.remove(u64(i));
+  }
+  assert_eq(map.len(), 5000u);
+  for (auto i = 0u; i < 10000; ++i) {
+    const auto x = map.get(u64(i));
+    assert(i % 2 == 0 ? x.is_none() : ~x == u64(i) * i, "grow: lookup after rehash");
+  }
+}
+
+sfc_test(upsert) {
+  auto map = ConcurrentHashMap<u32, u64>{};
+  auto calls = sync::Atomic<u32>{0};
+
+  auto thrs = Vec<thread::Thread>{};
+  for (auto t = 0u; t < 4; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([&map, &calls]() mutable {
+      for (auto i = 0u; i < 4000; ++i) {
+        map.upsert(i % 100, [](Option<const u64&> old) { return old ? ~old + 1 : u64(1); });
+        map.get_or_insert_with(1000 + i % 10, [&] {
+          calls.fetch_add(1);
+          return u64(i % 10);
+        });
+        (void)map.get(i % 100);
+      }
+    })));
+  }
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+
+  assert_eq(map.len(), 110u);
+  assert_eq(calls.load(), 10u);
+  for (auto i = 0u; i < 100; ++i) {
+    assert_eq(~map.get(i), 160u);
+  }
+  for (auto i = 0u; i < 10; ++i) {
+    assert_eq(~map.get(1000 + i), u64(i));
+  }
+}
+
+sfc_bench(get) {
+  auto map = ConcurrentHashMap<u64, u64>{};
+  for (auto i = 0u; i < 1024; ++i) {
+    map.insert(i, i);
+  }
+  auto i = u64(0);
+  b.set_items(1);
+  b.iter([&] { return map.get(i++ % 1024).unwrap_or(0); });
+}
+
+}  // namespace sfc::collections::concurrent_hash_map
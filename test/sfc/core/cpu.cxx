@@ -0,0 +1,70 @@
+#include "sfc/alloc.h"
+#include "sfc/test.h"
+
+namespace sfc::cpu {
+
+sfc_test(features) {
+  const auto& fs = cpu::features();
+#if defined(__x86_64__)
+  assert(fs.has(Feature::Sse2), "features: sse2 on x86-64");
+#endif
+  if (fs.has(Feature::Avx512bw)) {
+    assert(fs.has(Feature::Avx512f), "features: avx512bw implies avx512f");
+  }
+
+  const auto top = cpu::level();
+  if (top != Level::Base) {
+    assert(fs.has(Feature::Avx2) && fs.has(Feature::Bmi2) && fs.has(Feature::Popcnt), "level: x86-64-v3");
+  }
+  if (top == Level::Avx512) {
+    assert(fs.has(Feature::Avx512bw) && fs.has(Feature::Avx512vl), "level: x86-64-v4");
+  }
+
+  const auto s = string::format("{}", fs);
+  assert(fs._bits == 0 || !s.is_empty(), "format: feature names");
+}
+
+// every clone the cpu can run gives the same answers.
+sfc_test(dispatch) {
+  const auto top = cpu::level();
+  auto v = Vec<f32>{};
+  for (auto i = 0u; i < 5000; ++i) {
+    v.push(f32(i % 97) - 48.0f);
+  }
+  v[4321] = 100.0f;
+  const auto s = v.as_slice();
+  auto text = String{};
+  for (auto i = 0u; i < 100; ++i) {
+    text.push_str("5000");
+  }
+  text.push_str("x");
+  const auto sum0 = s.sum();
+
+  // rounding at every add: the order of the adds must not depend on the isa.
+  auto f = Vec<f32>{};
+  auto x = u32(1);
+  for (auto i = 0u; i < 100003; ++i) {
+    x = x * 1664525 + 1013904223;
+    f.push(f32(i32(x >> 16) - 32768) * 0.37f * f32(1 + i % 7 * 1000));
+  }
+  const auto fsum0 = f.as_slice().sum();
+
+  const Level levels[] = {Level::Base, Level::Avx2, Level::Avx512};
+  for (auto level : levels) {
+    cpu::set_level(level);
+    assert(cpu::level() <= top && cpu::level() <= level, "set_level: capped");
+    assert_eq(s.sum(), sum0);
+    assert_eq(f.as_slice().sum(), fsum0);
+    assert_eq(s.argmax().unwrap(), 4321u);
+    assert_eq(s.count(0.0f), 52u);
+    assert_eq(s.rfind(-48.0f).unwrap(), 4947u);
+    assert_eq(text.find("0500050").unwrap(), 3u);
+    assert_eq(text.find("0x").unwrap(), 399u);
+    assert_eq(text.find('x').unwrap(), 400u);
+    assert(text.find("50x").is_none(), "find: str");
+  }
+  cpu::set_level(top);
+  assert(cpu::level() == top, "set_level: restored");
+}
+
+}  // namespace sfc::cpu
@@ -23,6 +23,9 @@ sfc_test(fmt_flt) {
   sfc::assert_eq(*string::format("{.0f}", 12.345), "12");
   sfc::assert_eq(*string::format("{.1f}", 12.345), "12.3");
   sfc::assert_eq(*string::format("{.2f}", 12.345), "12.35");
+  sfc::assert_eq(*string::format("{.1f}", 0.96), "1.0");
+  sfc::assert_eq(*string::format("{.2f}", 9.999), "10.00");
+  sfc::assert_eq(*string::format("{.1f}", -0.96), "-1.0");
 
   sfc::assert_eq(*string::format("{.3}", 12.345), "12.3");
   sfc::assert_eq(*string::format("{.4}", 12.345), "12.35");
@@ -35,4 +38,24 @@ sfc_test(fmt_flt) {
   sfc::assert_eq(*string::format("{^8.2}", -1.2), "  -1.2  ");
 }
 
+sfc_bench(fmt_int) {
+  auto buf = String{};
+  const auto x = test::black_box(-1234567);
+  b.iter([&] {
+    buf.clear();
+    fmt::Formatter{buf}.write("{}", x);
+    return buf.len();
+  });
+}
+
+sfc_bench(fmt_flt) {
+  auto buf = String{};
+  const auto x = test::black_box(3.14159265);
+  b.iter([&] {
+    buf.clear();
+    fmt::Formatter{buf}.write("{.6}", x);
+    return buf.len();
+  });
+}
+
 } // namespace sfc::fmt
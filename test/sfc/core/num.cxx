@@ -28,4 +28,10 @@ sfc_test(int_from_str) {
   //assert_eq(Str{"-15"}.parse<i32>(), Option{-15});
 }
 
+sfc_bench(parse_int) {
+  const auto s = test::black_box(Str{"-1234567890"});
+  b.set_bytes(s.len());
+  b.iter([&] { return test::black_box(s).parse<i64>().unwrap_or(0); });
+}
+
 }  // namespace sfc::num
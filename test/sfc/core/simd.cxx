@@ -0,0 +1,131 @@
+#include "sfc/alloc.h"
+#include "sfc/test.h"
+
+namespace sfc::ptr::simd {
+
+// every length around the 64-byte steps, every position of the match.
+template <class T>
+static void check_scans() {
+  for (usize n = 0; n < 200; ++n) {
+    auto v = Vec<T>{};
+    for (usize i = 0; i < n; ++i) {
+      v.push(T(i % 7 + 1));
+    }
+    const auto s = v.as_slice();
+    assert_eq(s.count(T(3)), n / 7 + (n % 7 > 2));
+    assert(s.find(T(0)).is_none() && s.rfind(T(0)).is_none(), "find: missing");
+    assert(!s.contains(T(0)), "contains: missing");
+
+    for (usize k = 0; k < n; ++k) {
+      v[k] = T(0);
+      assert_eq(s.find(T(0)).unwrap(), k);
+      assert_eq(s.rfind(T(0)).unwrap(), k);
+      assert_eq(s.argmin().unwrap(), k);
+
+      auto w = Vec<T>{};
+      w.extend_from_slice(s);
+      w[k] = T(1);
+      assert(s != w.as_slice(), "eq: one item differs");
+      assert((s <=> w.as_slice()) == cmp::Ordering::Less, "cmp: first difference decides");
+      v[k] = T(k % 7 + 1);
+    }
+    assert(s == v.as_slice(), "eq: itself");
+  }
+}
+
+sfc_test(scans) {
+  check_scans<u8>();
+  check_scans<i16>();
+  check_scans<u32>();
+  check_scans<i64>();
+  check_scans<f32>();
+  check_scans<f64>();
+  check_scans<long long>();
+}
+
+sfc_test(min_max) {
+  auto v = Vec<i8>{};
+  for (auto i = 0; i < 300; ++i) {
+    v.push(i8(i * 37));
+  }
+  auto lo = i8(127);
+  auto hi = i8(-128);
+  for (usize i = 0; i < v.len(); ++i) {
+    lo = v[i] < lo ? v[i] : lo;
+    hi = v[i] > hi ? v[i] : hi;
+  }
+  assert_eq(v.as_slice().min().unwrap(), lo);
+  assert_eq(v.as_slice().max().unwrap(), hi);
+  assert_eq(v[v.as_slice().argmax().unwrap()], hi);
+  assert(Slice<const u32>{}.min().is_none(), "min: empty");
+
+  const auto nan = __builtin_nanf("");
+  auto f = Vec<f32>{};
+  for (auto i = 0; i < 100; ++i) {
+    f.push(nan);
+  }
+  assert(f.as_slice().min().is_none() && f.as_slice().argmax().is_none(), "min: all nan");
+  f[70] = __builtin_inff();
+  f[90] = -2.0f;
+  assert_eq(f.as_slice().min().unwrap(), -2.0f);
+  assert_eq(f.as_slice().argmax().unwrap(), 70u);
+  assert_eq(f.as_slice().argmin().unwrap(), 90u);
+}
+
+sfc_test(sum) {
+  auto v = Vec<u8>{};
+  auto w = Vec<i32>{};
+  auto total = u64(0);
+  for (auto i = 0u; i < 1000; ++i) {
+    v.push(u8(i));
+    w.push(i32(i) - 600);
+    total += u8(i);
+  }
+  assert_eq(v.as_slice().sum(), u8(total));
+  assert_eq(w.as_slice().sum(), 999 * 1000 / 2 - 600 * 1000);
+
+  // a large sum plus many small terms: added one by one, each rounds away.
+  auto f = Vec<f32>{};
+  f.push(1e8f);
+  for (auto i = 0u; i < 100000; ++i) {
+    f.push(1.0f);
+  }
+  const auto s = f.as_slice().sum();
+  assert(s > 1.0009e8f && s < 1.0011e8f, "sum: pairwise");
+}
+
+static auto column(usize n) -> Vec<u32> {
+  auto v = Vec<u32>::with_capacity(n);
+  auto x = u32(1);
+  for (usize i = 0; i < n; ++i) {
+    x = x * 1664525 + 1013904223;
+    v.push(x >> 8);
+  }
+  return v;
+}
+
+sfc_bench(find_u32) {
+  static constexpr usize N = 1 << 16;
+  const auto v = column(N);
+  b.set_items(N);
+  b.iter([&] { return v.as_slice().find(0).is_some(); });
+}
+
+sfc_bench(count_u32) {
+  static constexpr usize N = 1 << 16;
+  const auto v = column(N);
+  b.set_items(N);
+  b.iter([&] { return v.as_slice().count(7); });
+}
+
+sfc_bench(sum_f32) {
+  static constexpr usize N = 1 << 16;
+  auto v = Vec<f32>::with_capacity(N);
+  for (usize i = 0; i < N; ++i) {
+    v.push(f32(i % 1000) * 0.001f);
+  }
+  b.set_items(N);
+  b.iter([&] { return v.as_slice().sum(); });
+}
+
+}  // namespace sfc::ptr::simd
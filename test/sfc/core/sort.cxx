@@ -0,0 +1,197 @@
+#include "sfc/alloc.h"
+#include "sfc/test.h"
+
+namespace sfc::slice::sort {
+
+struct Rng {
+  u64 _seed;
+
+  auto next() -> u64 {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 7;
+    _seed ^= _seed << 17;
+    return _seed;
+  }
+};
+
+struct Rec {
+  i64 _key;
+  u32 _idx;
+};
+
+// the shapes that trip up quicksorts.
+static auto make(usize n, u32 kind) -> Vec<u32> {
+  auto rng = Rng{n * 31 + kind + 1};
+  auto v = Vec<u32>::with_capacity(n);
+  for (usize i = 0; i < n; ++i) {
+    switch (kind) {
+      case 0: v.push(u32(rng.next())); break;
+      case 1: v.push(u32(i)); break;
+      case 2: v.push(u32(n - i)); break;
+      case 3: v.push(7); break;
+      case 4: v.push(u32(i % 16)); break;
+      case 5: v.push(u32(i < n / 2 ? i : n - i)); break;
+      default: v.push(u32(rng.next() % 4)); break;
+    }
+  }
+  return v;
+}
+
+static auto sum(Slice<const u32> v) -> u64 {
+  auto res = u64(0);
+  for (usize i = 0; i < v.len(); ++i) {
+    res += u64(v[i]) * v[i];
+  }
+  return res;
+}
+
+sfc_test(sort_unstable) {
+  const usize lens[] = {0, 1, 2, 7, 20, 21, 50, 100, 1000, 30000};
+  for (auto n : lens) {
+    for (auto kind = 0u; kind < 7; ++kind) {
+      auto v = make(n, kind);
+      const auto s0 = sum(v.as_slice());
+      v.as_mut_slice().sort_unstable();
+      assert(v.as_slice().is_sorted(), "sort_unstable: sorted");
+      assert_eq(sum(v.as_slice()), s0);
+
+      v.as_mut_slice().sort_unstable_by([](u32 a, u32 b) { return a > b; });
+      assert(v.as_slice().is_sorted_by([](u32 a, u32 b) { return a > b; }), "sort_unstable_by: reversed");
+    }
+  }
+}
+
+sfc_test(sort_stable) {
+  const usize lens[] = {0, 1, 5, 20, 21, 100, 255, 256, 5000};
+  for (auto n : lens) {
+    auto rng = Rng{n + 1};
+    auto v = Vec<Rec>::with_capacity(n);
+    for (usize i = 0; i < n; ++i) {
+      v.push(Rec{i64(rng.next() % 64) - 32, u32(i)});
+    }
+
+    // merge sort, and radix sort by key from 256 on.
+    auto w = Vec<Rec>::with_capacity(n);
+    for (usize i = 0; i < n; ++i) {
+      w.push(v[i]);
+    }
+    v.as_mut_slice().sort_by([](const Rec& a, const Rec& b) { return a._key < b._key; });
+    w.as_mut_slice().sort_by_key([](const Rec& r) { return r._key; });
+    for (usize i = 1; i < n; ++i) {
+      const auto& a = v[i - 1];
+      const auto& b = v[i];
+      assert(a._key < b._key || (a._key == b._key && a._idx < b._idx), "sort_by: stable");
+      assert(w[i]._key == b._key && w[i]._idx == b._idx, "sort_by_key: same as sort_by");
+    }
+  }
+
+  auto u = make(3000, 0);
+  u.as_mut_slice().sort();
+  assert(u.as_slice().is_sorted(), "sort: radix");
+}
+
+sfc_test(sort_floats) {
+  auto v = Vec<f64>{};
+  const f64 xs[] = {1.5, -0.0, 0.0, -__builtin_inf(), __builtin_inf(), -2.0, 3.0, __builtin_nan("")};
+  for (auto i = 0u; i < 300; ++i) {
+    v.push(xs[i % 8]);
+  }
+  v.as_mut_slice().sort();
+  assert_eq(v[0], -__builtin_inf());
+  assert(__builtin_isnan(v[299]), "sort: nan last");
+  assert(__builtin_signbit(v[112]) && !__builtin_signbit(v[113]), "sort: -0 before +0");
+  for (usize i = 1; i < 263; ++i) {
+    assert(v[i - 1] <= v[i], "sort: floats");
+  }
+
+  // too short for the radix passes, but in the same order.
+  f64 w[] = {3.0, __builtin_nan(""), 0.0, -2.0, __builtin_inf(), -0.0, 1.5, -__builtin_inf(), 0.0, -0.0};
+  Slice{w}.sort();
+  assert_eq(w[0], -__builtin_inf());
+  assert(__builtin_isnan(w[9]), "sort: short, nan last");
+  assert(__builtin_signbit(w[2]) && __builtin_signbit(w[3]), "sort: short, -0 first");
+  assert(!__builtin_signbit(w[4]) && !__builtin_signbit(w[5]), "sort: short, +0 after");
+  for (usize i = 1; i < 9; ++i) {
+    assert(w[i - 1] <= w[i], "sort: short floats");
+  }
+}
+
+// heap owning items, moved bitwise; a panic half way must not lose or
+// duplicate any of them.
+sfc_test(sort_strings) {
+  const auto less = [](const String& a, const String& b) { return (*a <=> *b) == cmp::Ordering::Less; };
+  auto rng = Rng{42};
+  auto v = Vec<String>{};
+  for (auto i = 0u; i < 2000; ++i) {
+    v.push(string::format("item-{}", rng.next() % 500));
+  }
+  const auto checksum = [&] {
+    auto res = u64(0);
+    for (usize i = 0; i < v.len(); ++i) {
+      res += hash::hash(*v[i]);
+    }
+    return res;
+  };
+  const auto sum0 = checksum();
+  v.as_mut_slice().sort_unstable_by(less);
+  assert(v.as_slice().is_sorted_by(less), "sort_unstable_by: strings");
+
+  for (auto stop = 100u; stop < 40000; stop *= 3) {
+    auto cnt = 0u;
+    const auto bad = [&](const String& a, const String& b) {
+      if (++cnt == stop) {
+        throw panicking::Error{};
+      }
+      return (*b <=> *a) == cmp::Ordering::Less;
+    };
+    try {
+      v.as_mut_slice().sort_by(bad);
+    } catch (...) {
+    }
+    try {
+      v.as_mut_slice().sort_unstable_by(bad);
+    } catch (...) {
+    }
+  }
+  v.as_mut_slice().sort_by(less);
+  assert(v.as_slice().is_sorted_by(less), "sort_by: after panics");
+  assert_eq(checksum(), sum0);
+}
+
+sfc_bench(sort_unstable_u32) {
+  static constexpr usize N = 10000;
+  const auto src = make(N, 0);
+  auto v = Vec<u32>::with_capacity(N);
+  b.set_items(N);
+  b.iter([&] {
+    v.clear();
+    v.extend_from_slice(src.as_slice());
+    v.as_mut_slice().sort_unstable();
+  });
+}
+
+sfc_bench(sort_radix_u32) {
+  static constexpr usize N = 10000;
+  const auto src = make(N, 0);
+  auto v = Vec<u32>::with_capacity(N);
+  b.set_items(N);
+  b.iter([&] {
+    v.clear();
+    v.extend_from_slice(src.as_slice());
+    v.as_mut_slice().sort();
+  });
+}
+
+sfc_bench(sort_merge_u32) {
+  static constexpr usize N = 10000;
+  const auto src = make(N, 0);
+  auto v = Vec<u32>::with_capacity(N);
+  b.set_items(N);
+  b.iter([&] {
+    v.clear();
+    v.extend_from_slice(src.as_slice());
+    v.as_mut_slice().sort_by([](u32 a, u32 b) { return a < b; });
+  });
+}
+
+}  // namespace sfc::slice::sort
@@ -4,11 +4,65 @@
 
 using namespace sfc;
 
+// sfc-test [--jobs n] [+mod|-mod]...         runs the tests, on n threads (0: one per cpu)
+// sfc-test --bench [--time ms] [--perf] [--json path] [--csv path] [+mod|-mod]...
+//                                            runs the benches instead; --perf adds
+//                                            hardware counters per iteration
+// sfc-test --bench --baseline path [--threshold pct] [+mod|-mod]...
+//                                            compares against a saved --json file,
+//                                            and fails when anything got slower
 int main(int argc, const char* argv[]) {
   vec::Vec<Str> args;
+  auto bench = false;
+  auto json = Str{};
+  auto csv = Str{};
+  auto baseline = Str{};
+  auto threshold = 5.0;
+  auto jobs = usize(1);
+  auto opts = test::BenchOptions{};
+
   for (int i = 1; i < argc; ++i) {
-    args.push(Str::from_cstr(argv[i]));
+    const auto arg = Str::from_cstr(argv[i]);
+    const auto val = i + 1 < argc ? Str::from_cstr(argv[i + 1]) : Str{};
+    if (arg == "--bench") {
+      bench = true;
+    } else if (arg == "--jobs" || arg == "-j") {
+      jobs = val.parse<usize>().unwrap_or(0), ++i;
+    } else if (arg == "--json") {
+      json = val, ++i;
+    } else if (arg == "--csv") {
+      csv = val, ++i;
+    } else if (arg == "--baseline") {
+      baseline = val, ++i;
+    } else if (arg == "--threshold") {
+      threshold = val.parse<f64>().unwrap_or(5.0), ++i;
+    } else if (arg == "--perf") {
+      opts._perf = true;
+    } else if (arg == "--time") {
+      opts._measure_ns = val.parse<u64>().unwrap_or(500) * 1000000, ++i;
+    } else {
+      args.push(arg);
+    }
+  }
+
+  if (!bench) {
+    const auto failed = test::manager().run({args.as_slice()}, jobs);
+    return failed == 0 ? 0 : 1;
+  }
+
+  const auto res = test::manager().run_benches({args.as_slice()}, opts);
+  if (!json.is_empty()) {
+    test::write_json(json, res.as_slice());
+  }
+  if (!csv.is_empty()) {
+    test::write_csv(csv, res.as_slice());
+  }
+  if (!baseline.is_empty()) {
+    const auto base = test::read_json(baseline);
+    const auto deltas = test::compare(base.as_slice(), res.as_slice());
+    if (test::report(deltas.as_slice(), threshold / 100) != 0) {
+      return 1;
+    }
   }
-  test::manager().run({args.as_slice()});
   return 0;
 }
@@ -53,4 +53,38 @@ sfc_test(ndarray_3d) {
   }
 }
 
+sfc_test(ndarray_padded) {
+  auto a = math::NdArray<f32, 3>::with_dims_padded({10, 7, 3});
+  assert_eq(a.step(), Step<3>{1, 16, 112});
+  assert_eq(usize(a.as_ptr()) % 64, 0u);
+  assert(!a.is_array(), "padded rows are not dense");
+
+  a <<= Linspace{1.0f, 100.0f, 10000.0f};
+  for (auto y = 0u; y < 7; ++y) {
+    assert_eq(usize(&a[{0, y, 2}]) % 64, 0u);
+    assert_eq(a[{9, y, 2}], 9.0f + f32(y) * 100.0f + 20000.0f);
+  }
+
+  auto b = math::NdArray<f32, 3>::with_dims_padded({10, 7, 3});
+  b << *a;
+  auto c = math::NdArray<f32, 3>::with_dims_padded({10, 7, 3});
+  a >> *c;
+  assert_eq(b[{3, 4, 1}], a[{3, 4, 1}]);
+  assert_eq(c[{3, 4, 1}], a[{3, 4, 1}]);
+
+  // a row of exactly 4K gets one more cache line.
+  auto d = math::NdArray<f32, 2>::with_dims_padded({1024, 4});
+  assert_eq(d.step(), Step<2>{1, 1040});
+  assert_eq(d.span(), 4160u);
+
+  auto e = math::NdArray<f32, 2>::with_dims_padded({32, 4});
+  assert(e.is_array(), "rows of whole cache lines need no padding");
+
+  // transposed: the last dim has the smallest step.
+  auto t = math::NdArray<f32, 2>::with_dims_step({5, 3}, {3, 1});
+  assert_eq(t.span(), 15u);
+  t[{4, 2}] = 7.0f;
+  assert_eq(t[{4, 2}], 7.0f);
+}
+
 }  // namespace sfc::math
@@ -47,4 +47,112 @@ sfc_test(array_2d_slice) {
   log::info("a[0:2, 0:2] = {5.2f}", a.slice({0, 2}, {0, 2}));
 }
 
+template <class F, class G>
+static auto check_fn(F, G g, f32 x0, f32 x1, f32 tol) -> void {
+  auto n = 1001u;
+  auto x = NdArray<f32, 1>::with_dims({n});
+  auto y = NdArray<f32, 1>::with_dims({n});
+  x <<= Linspace{(x1 - x0) / f32(n)} + x0;
+  y <<= Map<F(NdSlice<f32, 1>)>{*x};
+
+  for (auto i = 0u; i < n; ++i) {
+    const auto e = g(x[i]);
+    const auto d = num::abs(y[i] - e);
+    sfc::assert(d <= tol * (1.0f + num::abs(e)), "x={}, y={}, expect={}", x[i], y[i], e);
+  }
+}
+
+sfc_test(simd_map) {
+  auto n = 37u;  // two packets and a partial one
+
+  auto a = NdArray<f32, 1>::with_dims({n});
+  auto b = NdArray<f32, 1>::with_dims({n});
+  a <<= Linspace{0.5f};
+  b <<= 2.0f;
+
+  auto c = NdArray<f32, 1>::with_dims({n});
+  c <<= a * b - a;
+  for (auto i = 0u; i < n; ++i) {
+    assert_eq(c[i], f32(i) * 0.5f);
+  }
+
+  auto u = NdArray<i32, 1>::with_dims({n});
+  auto v = NdArray<i32, 1>::with_dims({n});
+  u <<= Linspace{1} + 1;
+  v <<= (u + 1) / u;  // the partial packet must not divide by zero
+  for (auto i = 0u; i < n; ++i) {
+    assert_eq(v[i], (i32(i) + 2) / (i32(i) + 1));
+  }
+}
+
+sfc_test(simd_compare) {
+  auto n = 37u;  // two packets and a partial one
+
+  auto a = NdArray<i32, 1>::with_dims({n});
+  auto b = NdArray<i32, 1>::with_dims({n});
+  a <<= Linspace{1};
+  b <<= 18;
+
+  // a true lane is 1, as for a `bool`, not the all ones of a packet mask.
+  auto y = NdArray<i32, 1>::with_dims({n});
+  y <<= *a < *b;
+  for (auto i = 0u; i < n; ++i) {
+    assert_eq(y[i], i < 18 ? 1 : 0);
+  }
+  y <<= 1;
+  y.assign<AddAssign>(*a >= *b);
+  assert_eq(fold_all<Add>(*y), i32(n + n - 18));
+
+  assert_eq(fold_all<Add>(*a < *b), 18);
+  assert_eq(fold_all<Add>(*a == *b), 1);
+
+  auto f = NdArray<f32, 1>::with_dims({n});
+  auto g = NdArray<f32, 1>::with_dims({n});
+  f <<= Linspace{0.5f};
+  g <<= 9.0f;
+  assert_eq(fold_all<Add>(*f < *g), 18);
+}
+
+sfc_test(simd_strided) {
+  auto n = usize(20);
+  auto a = NdArray<f32, 2>::with_dims({3, n});
+  a <<= 0.0f;
+
+  auto col = a.slice({1}, _);
+  col.assign<Assign>(Linspace{1.0f});
+  for (auto i = 0u; i < n; ++i) {
+    assert_eq(a[{0, i}], 0.0f);
+    assert_eq(a[{1, i}], f32(i));
+    assert_eq(a[{2, i}], 0.0f);
+  }
+}
+
+sfc_test(simd_fn) {
+  check_fn(Exp{}, [](f32 x) { return __builtin_expf(x); }, -80.0f, 80.0f, 2e-6f);
+  check_fn(Log{}, [](f32 x) { return __builtin_logf(x); }, 1e-6f, 1e6f, 2e-6f);
+  check_fn(Sin{}, [](f32 x) { return __builtin_sinf(x); }, -100.0f, 100.0f, 2e-6f);
+  check_fn(Cos{}, [](f32 x) { return __builtin_cosf(x); }, -100.0f, 100.0f, 2e-6f);
+  check_fn(TanH{}, [](f32 x) { return __builtin_tanhf(x); }, -10.0f, 10.0f, 2e-6f);
+}
+
+sfc_test(reduce) {
+  auto n = usize(40);
+  auto a = NdArray<f32, 2>::with_dims({n, 3});
+  for (auto k = 0u; k < 3; ++k) {
+    for (auto i = 0u; i < n; ++i) {
+      a[{i, k}] = f32(i + 100 * k);
+    }
+  }
+
+  auto s = NdArray<f32, 1>::with_dims({3});
+  s <<= Reduce<Add(NdSlice<f32, 2>)>{*a};
+  auto m = NdArray<f32, 1>::with_dims({3});
+  m <<= Reduce<Max(NdSlice<f32, 2>)>{*a};
+
+  for (auto k = 0u; k < 3; ++k) {
+    assert_eq(s[k], f32(n * (n - 1) / 2 + 100 * k * n));
+    assert_eq(m[k], f32(n - 1 + 100 * k));
+  }
+}
+
 } // namespace sfc::math
@@ -0,0 +1,80 @@
+#include "sfc/test.h"
+
+#include "sfc/log.h"
+#include "sfc/math.h"
+
+namespace sfc::math {
+
+template <class T>
+static auto gemm_naive(NdSlice<const T, 2> a, NdSlice<const T, 2> b, usize i, usize j) -> T {
+  auto s = T(0);
+  for (usize p = 0; p < a.dims()[0]; ++p) {
+    s += a[{p, i}] * b[{j, p}];
+  }
+  return s;
+}
+
+template <class T>
+static void gemm_fill(NdSlice<T, 2> a, u32 seed) {
+  for (usize i = 0; i < a.dims()[1]; ++i) {
+    for (usize j = 0; j < a.dims()[0]; ++j) {
+      seed = seed * 1103515245u + 12345u;
+      a[{j, i}] = T(i32(seed >> 16) % 17 - 8) / T(4);
+    }
+  }
+}
+
+template <class T>
+static void gemm_check(usize m, usize n, usize k) {
+  auto a = NdArray<T, 2>::with_dims({k, m});
+  auto b = NdArray<T, 2>::with_dims({n, k});
+  auto c = NdArray<T, 2>::with_dims({n, m});
+  gemm_fill(*a, 1);
+  gemm_fill(*b, 2);
+  gemm_fill(*c, 3);
+  auto c0 = NdArray<T, 2>::with_dims({n, m});
+  c0 <<= c;
+
+  math::gemm(T(2), a, b, T(-1), *c);
+  for (usize i = 0; i < m; ++i) {
+    for (usize j = 0; j < n; ++j) {
+      assert_eq(c[{j, i}], T(2) * gemm_naive<T>(a, b, i, j) - c0[{j, i}]);
+    }
+  }
+}
+
+sfc_test(gemm_shapes) {
+  gemm_check<f32>(1, 1, 1);
+  gemm_check<f32>(7, 17, 5);
+  gemm_check<f32>(13, 33, 300);
+  gemm_check<f64>(6, 8, 3);
+  gemm_check<f64>(19, 23, 140);
+  gemm_check<f32>(200, 150, 100);  // threaded
+}
+
+sfc_test(gemm_transpose) {
+  auto m = usize(9), n = usize(20), k = usize(11);
+  auto at = NdArray<f32, 2>::with_dims({m, k});
+  auto b = NdArray<f32, 2>::with_dims({n, k});
+  gemm_fill(*at, 4);
+  gemm_fill(*b, 5);
+
+  auto c = math::matmul(at.transpose(), b);
+  assert_eq(c.dims(), (Dims<2>{n, m}));
+  for (usize i = 0; i < m; ++i) {
+    for (usize j = 0; j < n; ++j) {
+      assert_eq(c[{j, i}], gemm_naive<f32>(at.transpose(), b, i, j));
+    }
+  }
+
+  // c^T = b^T * a^T, written through a transposed view of d
+  auto d = NdArray<f32, 2>::with_dims({n, m});
+  math::gemm(1.0f, b.transpose(), at, 0.0f, d.transpose());
+  for (usize i = 0; i < m; ++i) {
+    for (usize j = 0; j < n; ++j) {
+      assert_eq(d[{j, i}], c[{j, i}]);
+    }
+  }
+}
+
+}  // namespace sfc::math
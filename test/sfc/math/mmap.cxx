@@ -0,0 +1,59 @@
+#include "sfc/test.h"
+
+#include "sfc/math.h"
+#include "sfc/os.h"
+
+namespace sfc::math {
+
+sfc_test(mmap) {
+  // one file per process, so that concurrent runs keep apart.
+  const auto name = string::format("/tmp/sfc-test-mmap-{}.nd", os::process_id());
+  const auto path = name.as_str();
+  {
+    auto a = NdMmap<f32, 2>::create(path, {30, 20});
+    assert_eq(a.dims(), Dims<2>{30, 20});
+    assert_eq(a[{7, 5}], 0.0f);
+
+    a <<= Linspace{1.0f, 100.0f};
+    a.slice({0, 30}, {3}).assign<Assign>(9.0f);
+    a.flush();
+  }
+
+  {
+    auto b = NdMmap<const f32, 2>::open(path);
+    assert_eq(b.dims(), Dims<2>{30, 20});
+    assert_eq(b[{7, 3}], 9.0f);
+    assert_eq(b[{7, 5}], 507.0f);
+
+    auto s = b.slice({10, 20}, {2, 4});
+    assert_eq(s.dims(), Dims<2>{10, 2});
+    assert_eq(s[{0, 0}], 210.0f);
+    assert_eq(s[{9, 1}], 9.0f);
+  }
+
+  {
+    auto c = NdMmap<f32, 2>::open(path);
+    c[{0, 0}] = -1.0f;
+  }
+  assert_eq(NdMmap<const f32, 2>::open(path)[{0, 0}], -1.0f);
+
+  auto bad_dtype = false;
+  try {
+    (void)NdMmap<const i32, 2>::open(path);
+  } catch (io::Error::Kind e) {
+    bad_dtype = e == io::Error::InvalidData;
+  }
+  assert(bad_dtype, "mmap: dtype mismatch not detected");
+
+  auto bad_rank = false;
+  try {
+    (void)NdMmap<const f32, 1>::open(path);
+  } catch (io::Error::Kind e) {
+    bad_rank = e == io::Error::InvalidData;
+  }
+  assert(bad_rank, "mmap: rank mismatch not detected");
+
+  fs::remove_file(fs::Path{path});
+}
+
+}  // namespace sfc::math
@@ -0,0 +1,47 @@
+#include "sfc/test.h"
+
+#include "sfc/log.h"
+#include "sfc/math.h"
+
+namespace sfc::math {
+
+sfc_test(par_assign) {
+  auto pool = thread::Pool::with_num_threads(3);
+
+  auto n = usize(1) << 18;
+  auto a = NdArray<f32, 1>::with_dims({n});
+  auto b = NdArray<f32, 1>::with_dims({n});
+  par::assign<Assign>(*a, Linspace{1.0f}, pool);
+  par::assign<Assign>(*b, a * 2.0f + 1.0f, pool);
+  for (auto i = 0u; i < n; i += 97) {
+    assert_eq(a[i], f32(i));
+    assert_eq(b[i], f32(i) * 2.0f + 1.0f);
+  }
+
+  auto m = NdArray<u32, 2>::with_dims({1000, 300});
+  par::assign<Assign>(*m, 7u, pool);
+  par::assign<AddAssign>(*m, m, pool);
+  for (auto i = 0u; i < m.count(); i += 13) {
+    assert_eq(m.as_ptr()[i], 14u);
+  }
+}
+
+sfc_test(par_reduce) {
+  auto pool = thread::Pool::with_num_threads(3);
+
+  auto n = usize(1) << 18;
+  auto a = NdArray<i64, 1>::with_dims({n});
+  a <<= Linspace{i64(1)};
+  assert_eq(par::reduce<Add>(a, pool), i64(n * (n - 1) / 2));
+  assert_eq(par::reduce<Max>(a, pool), i64(n - 1));
+
+  auto m = NdArray<i64, 2>::with_dims({500, 400});
+  m <<= 3;
+  assert_eq(par::reduce<Add>(m, pool), i64(3 * 500 * 400));
+
+  auto r = NdArray<i64, 1>::with_dims({400});
+  par::assign<Assign>(*r, Reduce<Add(NdSlice<i64, 2>)>{*m}, pool);
+  assert_eq(r[399], i64(3 * 500));
+}
+
+}  // namespace sfc::math
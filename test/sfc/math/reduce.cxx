@@ -0,0 +1,113 @@
+#include "sfc/test.h"
+
+#include "sfc/log.h"
+#include "sfc/math.h"
+
+namespace sfc::math {
+
+sfc_test(reduce_axis) {
+  auto a = NdArray<i32, 3>::with_dims({5, 4, 3});
+  for (usize z = 0; z < 3; ++z) {
+    for (usize y = 0; y < 4; ++y) {
+      for (usize x = 0; x < 5; ++x) {
+        a[{x, y, z}] = i32(x + 10 * y + 100 * z);
+      }
+    }
+  }
+
+  auto s0 = reduce_axis<Add>(a, 0);
+  auto s1 = reduce_axis<Add>(a, 1);
+  auto s2 = reduce_axis<Max>(a, 2);
+  assert_eq(s0.dims(), (Dims<2>{4, 3}));
+  assert_eq(s1.dims(), (Dims<2>{5, 3}));
+  assert_eq(s2.dims(), (Dims<2>{5, 4}));
+
+  for (usize z = 0; z < 3; ++z) {
+    for (usize y = 0; y < 4; ++y) {
+      assert_eq(s0[{y, z}], i32(10 + 5 * (10 * y + 100 * z)));
+    }
+    for (usize x = 0; x < 5; ++x) {
+      assert_eq(s1[{x, z}], i32(60 + 4 * (x + 100 * z)));
+    }
+  }
+  for (usize y = 0; y < 4; ++y) {
+    for (usize x = 0; x < 5; ++x) {
+      assert_eq(s2[{x, y}], i32(x + 10 * y + 200));
+    }
+  }
+}
+
+sfc_test(reduce_sum) {
+  auto n = usize(1) << 20;
+  auto a = NdArray<f32, 1>::with_dims({n});
+  a <<= 0.1f;
+
+  auto naive = 0.0f;
+  for (usize i = 0; i < n; ++i) {
+    naive += a[i];
+  }
+  const auto exact = f64(0.1f) * f64(n);
+  const auto err = [&](f32 s) { return num::abs(f64(s) - exact) / exact; };
+
+  log::info("sum: naive err={}, pairwise err={}, kahan err={}", err(naive), err(pairwise_sum(a)), err(kahan_sum(a)));
+  sfc::assert(err(pairwise_sum(a)) < 1e-6, "pairwise_sum");
+  sfc::assert(err(kahan_sum(a)) < 1e-6, "kahan_sum");
+}
+
+sfc_test(summarize) {
+  auto n = usize(1000) + 7;
+  auto a = NdArray<f64, 1>::with_dims({n});
+  for (usize i = 0; i < n; ++i) {
+    a[i] = 1e6 + f64((i * 37) % 101);
+  }
+  a[500] = 1e6 + 100;  // ties with earlier maxima, index must stay the first
+  a[900] = 1e6 - 3;
+
+  const auto s = summarize(a);
+  auto sum = 0.0;
+  auto argmax = usize(0);
+  for (usize i = 0; i < n; ++i) {
+    sum += a[i];
+    argmax = a[i] > a[argmax] ? i : argmax;
+  }
+  const auto mean = sum / f64(n);
+  auto var = 0.0;
+  for (usize i = 0; i < n; ++i) {
+    var += (a[i] - mean) * (a[i] - mean);
+  }
+  var /= f64(n);
+
+  assert_eq(s.count(), n);
+  assert_eq(s.sum(), sum);
+  assert_eq(s.min(), 1e6 - 3);
+  assert_eq(s.argmin(), usize(900));
+  assert_eq(s.max(), 1e6 + 100);
+  assert_eq(s.argmax(), argmax);
+  sfc::assert(num::abs(s.mean() - mean) < 1e-9, "mean");
+  sfc::assert(num::abs(s.var() - var) < 1e-6 * var, "var");
+}
+
+sfc_test(summarize_axis) {
+  auto a = NdArray<f32, 2>::with_dims({40, 3});
+  for (usize y = 0; y < 3; ++y) {
+    for (usize x = 0; x < 40; ++x) {
+      a[{x, y}] = f32(x * (y + 1));
+    }
+  }
+
+  auto rows = summarize_axis(a, 0);
+  auto cols = summarize_axis(a, 1);
+  for (usize y = 0; y < 3; ++y) {
+    assert_eq(rows[y].count(), usize(40));
+    assert_eq(rows[y].sum(), f32(780 * (y + 1)));
+    assert_eq(rows[y].argmax(), usize(39));
+  }
+  for (usize x = 0; x < 40; ++x) {
+    assert_eq(cols[x].count(), usize(3));
+    assert_eq(cols[x].mean(), f32(x * 2));
+    assert_eq(cols[x].max(), f32(x * 3));
+    assert_eq(cols[x].argmin(), usize(0));
+  }
+}
+
+}  // namespace sfc::math
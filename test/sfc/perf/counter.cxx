@@ -0,0 +1,53 @@
+#include "sfc/log.h"
+#include "sfc/perf.h"
+#include "sfc/test.h"
+
+namespace sfc::perf {
+
+sfc_test(counts) {
+  auto a = Counts{};
+  assert(a.is_empty(), "counts: empty");
+  a.set(Event::Cycles, 100);
+  a.set(Event::Instructions, 250);
+  assert_eq(~a.get(Event::Cycles), 100u);
+  assert(a.get(Event::PageFaults).is_none(), "counts: not counted");
+  assert_eq(~a.ipc(), 2.5);
+
+  auto b = Counts{};
+  b.set(Event::Cycles, 20);
+  b.set(Event::PageFaults, 3);
+  const auto c = a + b;
+  assert_eq(~c.get(Event::Cycles), 120u);
+  assert_eq(~c.get(Event::Instructions), 250u);
+  assert_eq(~c.get(Event::PageFaults), 3u);
+}
+
+// containers and vms often have no pmu, and then there is nothing to check.
+sfc_test(counter) {
+  auto ctr = Counter::open_default();
+  if (ctr.is_empty()) {
+    log::info("perf::counter: perf_event_open unavailable");
+    return;
+  }
+
+  auto sum = u64(0);
+  const auto cnt = ctr.measure([&] {
+    for (auto i = 0u; i < 1000000; ++i) {
+      sum += i;
+      test::do_not_optimize(sum);
+    }
+  });
+  assert_eq(sum, 1000000ull * 999999 / 2);
+  if (const auto ins = cnt.get(Event::Instructions)) {
+    assert(~ins >= 1000000, "counter: at least an instruction per iteration");
+  }
+
+  auto total = Counts{};
+  {
+    const auto r = Region{ctr, total};
+    test::do_not_optimize(sum);
+  }
+  assert(!total.is_empty(), "region: counted");
+}
+
+}  // namespace sfc::perf
@@ -37,4 +37,19 @@ sfc_test(ser) {
 
 sfc_test(de) {}
 
+sfc_test(query) {
+  const auto s = Str(R"({"id": 7, "skip": {"x": [1, "}]", {"y": null}]}, "a": {"b": [10, 20, {"c": "v"}]}, "k/~": 3})");
+
+  assert_eq(~Json::lookup(s, "/id"), Str("7"));
+  assert_eq(~Json::lookup(s, "/a/b/1"), Str("20"));
+  assert_eq(~Json::lookup(s, "/a/b/2/c"), Str(R"("v")"));
+  assert_eq(~Json::lookup(s, "/k~1~0"), Str("3"));
+  assert(Json::lookup(s, "/a/b/3").is_none());
+  assert(Json::lookup(s, "/a/x").is_none());
+
+  assert_eq(~Json::query(s, "/id").unwrap().as_int(), 7);
+  assert_eq(~Json::query(s, "/a/b/2/c").unwrap().as_str(), Str("v"));
+  assert_eq(Json::query(s, "/a/b").unwrap().as_list().unwrap().len(), 3u);
+}
+
 }  // namespace sfc::serial
@@ -0,0 +1,77 @@
+#include "sfc/test.h"
+#include "sfc/thread.h"
+
+namespace sfc::sync::channel {
+
+sfc_test(mpmc) {
+  auto [tx, rx] = channel::bounded<u64>(6);
+  assert_eq(tx.capacity(), 8u);
+
+  auto sum = Atomic<u64>{0};
+  auto thrs = Vec<thread::Thread>{};
+  for (auto t = 0u; t < 2; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([tx = tx, t]() mutable {
+      for (auto i = 0u; i < 10000; ++i) {
+        tx.send(u64(t * 10000 + i));
+      }
+    })));
+  }
+  for (auto t = 0u; t < 2; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([rx = rx, &sum]() mutable {
+      while (auto x = rx.recv()) {
+        sum.fetch_add(~x);
+      }
+    })));
+  }
+
+  // the last sender goes away with the producers, which ends the consumers.
+  (void)Sender<u64>{sfc::move(tx)};
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+  assert_eq(sum.load(), 19999u * 20000u / 2);
+  assert(rx.try_recv().is_none(), "mpmc: channel drained");
+}
+
+sfc_test(spsc) {
+  auto [tx, rx] = channel::spsc<u32>(4);
+
+  auto x = 7u;
+  for (auto i = 0u; i < 4; ++i) {
+    assert(tx.try_send(x), "spsc: room for 4 items");
+  }
+  assert(!tx.try_send(x), "spsc: full after 4 items");
+  assert_eq(~rx.try_recv(), 7u);
+
+  auto out = Vec<u32>{};
+  assert_eq(rx.recv_many(out, 8), 3u);
+  assert(rx.try_recv().is_none(), "spsc: empty");
+
+  auto prod = thread::Thread::xnew(Box<void()>::xnew([tx = sfc::move(tx)]() mutable {
+    u32 buf[100];
+    for (auto i = 0u; i < 100; ++i) {
+      buf[i] = i;
+    }
+    for (auto k = 0u; k < 10; ++k) {
+      tx.send_many({buf, 100});
+    }
+  }));
+
+  out.clear();
+  while (rx.recv_many(out, 16) != 0) {
+  }
+  prod.join();
+  assert_eq(out.len(), 1000u);
+  for (auto i = 0u; i < out.len(); ++i) {
+    assert_eq(out[i], i % 100);
+  }
+}
+
+sfc_test(disconnect) {
+  auto [tx, rx] = channel::bounded<String>(2);
+  assert(tx.send(String::from_str("a")), "disconnect: receiver alive");
+  (void)Receiver<String>{sfc::move(rx)};
+  assert(!tx.send(String::from_str("b")), "disconnect: receiver gone");
+}
+
+}  // namespace sfc::sync::channel
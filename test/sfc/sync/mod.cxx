@@ -0,0 +1,170 @@
+#include "sfc/test.h"
+#include "sfc/thread.h"
+
+namespace sfc::sync {
+
+sfc_test(mutex) {
+  auto mtx = XMutex<u32>{0};
+  auto thrs = Vec<thread::Thread>{};
+  for (auto t = 0u; t < 4; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([&]() mutable {
+      for (auto i = 0u; i < 10000; ++i) {
+        auto lock = mtx.lock();
+        *lock.operator->() += 1;
+      }
+    })));
+  }
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+  assert_eq(mtx._val, 40000u);
+
+  auto lock = mtx._mtx.lock();
+  assert(mtx._mtx.trylock().is_none(), "mutex: trylock on a locked mutex");
+}
+
+sfc_test(condvar) {
+  auto mtx = Mutex{};
+  auto cnd = Condvar{};
+  auto ready = 0u;
+  auto go = false;
+
+  auto thrs = Vec<thread::Thread>{};
+  for (auto t = 0u; t < 4; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([&]() mutable {
+      auto lock = mtx.lock();
+      ready += 1;
+      cnd.notify_all();
+      while (!go) {
+        cnd.wait(lock);
+      }
+    })));
+  }
+
+  {
+    auto lock = mtx.lock();
+    while (ready != 4) {
+      cnd.wait(lock);
+    }
+    go = true;
+    cnd.notify_all();
+  }
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+
+  auto lock = mtx.lock();
+  assert(!cnd.wait_timeout(lock, time::Duration::from_millis(1)), "condvar: wait_timeout without notify");
+}
+
+sfc_test(rwlock) {
+  auto rw = XRwLock<u64>{0};
+  auto thrs = Vec<thread::Thread>{};
+  for (auto t = 0u; t < 4; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([&, t]() mutable {
+      for (auto i = 0u; i < 5000; ++i) {
+        if ((i + t) % 4 == 0) {
+          auto w = rw.write();
+          *w.operator->() += 1;
+        } else {
+          auto r = rw.read();
+          assert(*r.operator->() <= 5000u, "rwlock: torn value");
+        }
+      }
+    })));
+  }
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+  assert_eq(rw._val, 5000u);
+
+  auto r1 = rw._lock.read();
+  auto r2 = rw._lock.try_read();
+  assert(r2.is_some(), "rwlock: readers share the lock");
+  assert(rw._lock.try_write().is_none(), "rwlock: writer while reading");
+}
+
+sfc_test(sharded_rwlock) {
+  auto rw = XRwLock<u64, ShardedRwLock>{0};
+  auto thrs = Vec<thread::Thread>{};
+  for (auto t = 0u; t < 4; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([&, t]() mutable {
+      for (auto i = 0u; i < 5000; ++i) {
+        if ((i + t) % 8 == 0) {
+          auto w = rw.write();
+          *w.operator->() += 1;
+        } else {
+          auto r = rw.read();
+          assert(*r.operator->() <= 2500u, "sharded_rwlock: torn value");
+        }
+      }
+    })));
+  }
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+  assert_eq(rw._val, 2500u);
+
+  auto r = rw._lock.read();
+  assert(rw._lock.try_read().is_some(), "sharded_rwlock: readers share the lock");
+  assert(rw._lock.try_write().is_none(), "sharded_rwlock: writer while reading");
+}
+
+sfc_test(seqlock) {
+  struct Pair {
+    u64 a;
+    u64 b;
+  };
+  auto sl = SeqLock<Pair>{._val = {0, 0}};
+  auto done = Atomic<u32>{0};
+
+  auto writer = thread::Thread::xnew(Box<void()>::xnew([&]() mutable {
+    for (auto i = 1u; i <= 20000; ++i) {
+      sl.update([&](Pair& p) {
+        p.a = i;
+        p.b = u64(i) * 3;
+      });
+    }
+    done.store(1);
+  }));
+
+  auto reads = 0u;
+  while (done.load() == 0 || reads == 0) {
+    const auto p = sl.load();
+    assert_eq(p.b, p.a * 3);
+    reads += 1;
+  }
+  writer.join();
+  assert_eq(sl.load().a, 20000u);
+}
+
+sfc_test(arc) {
+  struct Pair {
+    u32 a;
+    u32 b;
+  };
+  auto a = Arc{Pair{1, 2}};
+
+  auto thrs = Vec<thread::Thread>{};
+  auto sum = Atomic<u32>{0};
+  for (auto t = 0u; t < 4; ++t) {
+    thrs.push(thread::Thread::xnew(Box<void()>::xnew([a = a, &sum]() mutable {
+      for (auto i = 0u; i < 1000; ++i) {
+        auto b = a;
+        sum.fetch_add(b->a, Ordering::Relaxed);
+      }
+    })));
+  }
+  for (auto i = 0u; i < thrs.len(); ++i) {
+    thrs[i].join();
+  }
+  assert_eq(sum.load(), 4000u);
+  assert_eq(a.strong_count(), 1u);
+
+  auto b = a;
+  b.make_mut().b = 3;
+  assert_eq(a->b, 2u);
+  assert_eq(b->b, 3u);
+}
+
+}  // namespace sfc::sync
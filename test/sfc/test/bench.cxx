@@ -0,0 +1,26 @@
+#include "sfc/test.h"
+
+namespace sfc::test {
+
+sfc_test(stats) {
+  f64 ns[] = {5, 1, 4, 2, 3, 9, 7, 8, 6, 10};
+  const auto s = Stats::from_samples(ns, 100);
+  assert_eq(s._samples, 10u);
+  assert_eq(s._min, 1.0);
+  assert_eq(s._max, 10.0);
+  assert_eq(s._mean, 5.5);
+  assert_eq(s._median, 6.0);
+  assert_eq(s._p10, 2.0);
+  assert_eq(s._p90, 9.0);
+}
+
+sfc_test(bencher) {
+  auto b = Bencher{._opts = BenchOptions{._warmup_ns = 1000000, ._measure_ns = 5000000, ._samples = 10}};
+  auto n = u64(0);
+  b.iter([&] { return ++n; });
+  assert_eq(b._samples.len(), 10u);
+  assert(b._iters > 0 && n >= b._iters, "bencher: every iteration runs");
+  assert(b.stats()._median > 0, "bencher: timed");
+}
+
+}  // namespace sfc::test
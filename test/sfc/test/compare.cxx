@@ -0,0 +1,60 @@
+#include "sfc/fs.h"
+#include "sfc/os.h"
+#include "sfc/test.h"
+
+namespace sfc::test {
+
+static auto make_result(Str name, f64 base, f64 step) -> BenchResult {
+  auto ns = Vec<f64>{};
+  auto tmp = Vec<f64>{};
+  for (auto i = 0u; i < 40; ++i) {
+    ns.push(base + f64(i % 8) * step);
+    tmp.push(base + f64(i % 8) * step);
+  }
+  const auto stats = Stats::from_samples(tmp.as_mut_slice(), 40);
+  return BenchResult{String::from_str(name), stats, 1, 0, sfc::move(ns)};
+}
+
+sfc_test(compare) {
+  auto base = Vec<BenchResult>{};
+  base.push(make_result("a", 100, 1));
+  base.push(make_result("b", 100, 1));
+  base.push(make_result("c", 100, 1));
+
+  auto cur = Vec<BenchResult>{};
+  cur.push(make_result("a", 100, 1));
+  cur.push(make_result("b", 120, 1));
+  cur.push(make_result("c", 80, 1));
+  cur.push(make_result("d", 100, 1));
+
+  const auto deltas = test::compare(base.as_slice(), cur.as_slice());
+  assert_eq(deltas.len(), 3u);
+
+  assert(!deltas[0].is_regression(0.05), "compare: unchanged");
+  assert(!deltas[0].is_improvement(0.05), "compare: unchanged");
+  assert(deltas[1].is_regression(0.05), "compare: 20% slower");
+  assert(!deltas[1].is_regression(0.30), "compare: under threshold");
+  assert(deltas[2].is_improvement(0.05), "compare: 20% faster");
+  assert(deltas[1]._lo <= deltas[1]._change && deltas[1]._change <= deltas[1]._hi, "compare: interval");
+}
+
+sfc_test(json_roundtrip) {
+  const auto name = string::format("/tmp/sfc-test-bench-{}.json", os::process_id());
+  const auto path = name.as_str();
+
+  auto res = Vec<BenchResult>{};
+  res.push(make_result("sfc::x::a", 10, 0.5));
+  res.push(make_result("sfc::x::b", 20, 0.25));
+  test::write_json(path, res.as_slice());
+
+  const auto back = test::read_json(path);
+  fs::remove_file(fs::Path{path});
+
+  assert_eq(back.len(), 2u);
+  assert_eq(*back[1]._name, Str{"sfc::x::b"});
+  assert_eq(back[1]._samples.len(), 40u);
+  assert_eq(back[1]._items, 1u);
+  assert_eq(back[1]._stats._median, res[1]._stats._median);
+}
+
+}  // namespace sfc::test
@@ -0,0 +1,28 @@
+#include "sfc/test.h"
+
+namespace sfc::test {
+
+sfc_test(split_desc) {
+  const auto clang = test::split_desc("static sfc::test::Test sfc::test::Test::from_fn() [T = sfc::a::b::x_test]", "_test");
+  assert_eq(clang._0, Str{"sfc::a::b::"});
+  assert_eq(clang._1, Str{"x"});
+
+  const auto gcc = test::split_desc(
+      "static sfc::test::Bench sfc::test::Bench::from_fn() [with T = sfc::a::x_bench; sfc::test::Bench = sfc::test::Bench]",
+      "_bench");
+  assert_eq(gcc._0, Str{"sfc::a::"});
+  assert_eq(gcc._1, Str{"x"});
+
+  const auto msvc = test::split_desc("auto sfc::test::Test::from_fn<sfc::a::x_test>()->sfc::test::Test", "_test");
+  assert_eq(msvc._0, Str{"sfc::a::"});
+  assert_eq(msvc._1, Str{"x"});
+}
+
+sfc_test(str_find) {
+  assert_eq(~Str{"a::b"}.find(':'), 1u);
+  assert_eq(~Str{"a::b"}.find("::"), 1u);
+  assert_eq(~Str{"a::b"}.rfind(':'), 2u);
+  assert(Str{"a::b"}.find("c").is_none(), "find: missing");
+}
+
+}  // namespace sfc::test
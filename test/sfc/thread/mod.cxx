@@ -19,21 +19,80 @@ sfc_test(simple) {
   log::info("t2 = {}", mem::take(t2).join());
 }
 
-#if 0
 sfc_test(thread_pool) {
   auto pool = thread::Pool::with_num_threads(4);
 
-  log::info("pool push begin...");
+  auto sum = sync::Atomic<u32>{0};
+  pool.for_each(100, [&](usize i) { sum.fetch_add(u32(i)); });
+  assert_eq(sum.load(), 4950u);
 
-  for (auto i : ops::Range{0, 10}) {
-    pool.exec([i = i]() {
-      auto tid = thread::current().id();
-      log::info("thread[{}]: {}...", tid, i);
-      thread::sleep(time::Duration::from_millis(100));
-    });
+  // nested: workers waiting on an inner for_each must not starve it.
+  sum.store(0);
+  pool.for_each(8, [&](usize) { pool.for_each(8, [&](usize) { sum.fetch_add(1); }); });
+  assert_eq(sum.load(), 64u);
+}
+
+// the cpu this thread runs on is in its affinity mask, whatever cpuset or
+// `taskset` the tests were started under.
+static auto allowed_cpu() -> u32 {
+  return thread::current_cpu().unwrap_or(0);
+}
+
+sfc_test(topology) {
+  const auto cpus = CpuSet::from_list("0-3,8,10-11\n");
+  assert_eq(cpus.count(), 7u);
+  assert(cpus.contains(3) && cpus.contains(8) && !cpus.contains(9), "from_list: ranges");
+
+  const auto& topo = Topology::global();
+  assert(topo.num_cpus() >= 1, "topology: no cpus");
+  assert(topo.num_cores() <= topo.num_cpus(), "topology: more cores than cpus");
+  assert_eq(topo.primary_cpus().count(), topo.num_cores());
+
+  auto all = CpuSet{};
+  for (u32 n = 0; n < topo.num_nodes(); ++n) {
+    all = all | topo.node_cpus(n);
+  }
+  assert_eq(all.count(), topo.num_cpus());
+}
+
+sfc_test(builder) {
+  const auto cpu = allowed_cpu();
+  auto cpus = CpuSet{};
+  cpus.insert(cpu);
+
+  auto t = thread::Builder{}.name("sfc-builder").stack_size(256 << 10).affinity(cpus).spawn([=]() -> u32 {
+    return thread::current_cpu().unwrap_or(cpu);
+  });
+  assert_eq(mem::take(t).join(), cpu);
+}
+
+sfc_test(scope) {
+  u64 data[1000];
+  for (auto i = 0u; i < 1000; ++i) {
+    data[i] = i;
   }
-  log::info("pool push end...");
+
+  // the threads borrow halves of a stack array, and spawn more threads.
+  const auto xs = Slice<u64>{data};
+  u64 sums[2] = {};
+  thread::scope([&](Scope& s) {
+    s.spawn([&] {
+      for (auto i = 0u; i < 500; ++i) sums[0] += xs[i];
+    });
+    s.spawn([&] {
+      s.spawn([&] {
+        for (auto i = 500u; i < 1000; ++i) sums[1] += xs[i];
+      });
+    });
+  });
+  assert_eq(sums[0] + sums[1], 999u * 1000u / 2);
+
+  const auto n = thread::scope([&](Scope& s) {
+    s.spawn([&] { sums[0] = 0; });
+    return 7u;
+  });
+  assert_eq(n, 7u);
+  assert_eq(sums[0], 0u);
 }
-#endif
 
 }  // namespace sfc::thread
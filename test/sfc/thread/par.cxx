@@ -0,0 +1,106 @@
+#include "sfc/test.h"
+#include "sfc/thread.h"
+
+namespace sfc::thread {
+
+sfc_test(par_for_each) {
+  auto xs = Vec<u32>{};
+  for (auto i = 0u; i < 10000; ++i) {
+    xs.push(i);
+  }
+
+  thread::par_for_each(xs, [](u32& x) { x *= 2; });
+  for (auto i = 0u; i < xs.len(); ++i) {
+    assert_eq(xs[i], 2 * i);
+  }
+
+  auto cnt = sync::Atomic<u32>{0};
+  thread::par_for_each(ops::Range<usize>{10, 110}, [&](usize) { cnt.fetch_add(1); });
+  assert_eq(cnt.load(), 100u);
+}
+
+sfc_test(par_map) {
+  const auto ys = thread::par_map(ops::Range<usize>{0, 5000}, [](usize i) { return f64(i) * 0.5; });
+  assert_eq(ys.len(), 5000u);
+  for (auto i = 0u; i < ys.len(); ++i) {
+    assert_eq(ys[i], f64(i) * 0.5);
+  }
+
+  const auto zs = thread::par_map(ys, [](const f64& y) { return i64(y * 2); });
+  assert_eq(zs[4999], 4999);
+}
+
+sfc_test(par_fold) {
+  auto xs = Vec<u64>{};
+  for (auto i = 0u; i < 100000; ++i) {
+    xs.push(i);
+  }
+
+  const auto sum = thread::par_reduce(xs, u64(0), [](u64 a, u64 b) { return a + b; });
+  assert_eq(sum, 99999ull * 100000ull / 2);
+
+  const auto odd = thread::par_fold(
+      xs, usize(0), [](usize n, const u64& x) { return n + (x % 2); }, [](usize a, usize b) { return a + b; });
+  assert_eq(odd, 50000u);
+
+  // float sums come out the same on every run.
+  const auto a = thread::par_map(xs, [](const u64& x) { return 1.0 / f64(x + 1); });
+  const auto s1 = thread::par_reduce(a, 0.0, [](f64 x, f64 y) { return x + y; });
+  const auto s2 = thread::par_reduce(a, 0.0, [](f64 x, f64 y) { return x + y; });
+  assert_eq(s1, s2);
+}
+
+sfc_test(par_chunks) {
+  auto xs = Vec<u32>{};
+  for (auto i = 0u; i < 1001; ++i) {
+    xs.push(1);
+  }
+
+  auto cnt = sync::Atomic<u32>{0};
+  thread::par_chunks(xs, 100, [&](Slice<u32> chunk) {
+    assert(chunk.len() == 100 || chunk.len() == 1, "par_chunks: chunk size");
+    cnt.fetch_add(1);
+    for (auto i = 0u; i < chunk.len(); ++i) {
+      chunk[i] = chunk.len();
+    }
+  });
+  assert_eq(cnt.load(), 11u);
+  assert_eq(xs[0], 100u);
+  assert_eq(xs[1000], 1u);
+}
+
+sfc_test(par_sort) {
+  struct Rec {
+    u64 _key;
+    u32 _idx;
+  };
+
+  static constexpr usize N = 100000;
+  auto seed = u64(7);
+  auto v = Vec<Rec>::with_capacity(N);
+  for (usize i = 0; i < N; ++i) {
+    seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+    v.push(Rec{seed % 1000, u32(i)});
+  }
+  auto w = Vec<Rec>::with_capacity(N);
+  w.extend_from_slice(v.as_slice());
+
+  thread::par_sort_by(v, [](const Rec& a, const Rec& b) { return a._key < b._key; });
+  thread::par_sort_by_key(w, [](const Rec& r) { return r._key; });
+  for (usize i = 1; i < N; ++i) {
+    const auto& a = v[i - 1];
+    const auto& b = v[i];
+    assert(a._key < b._key || (a._key == b._key && a._idx < b._idx), "par_sort_by: stable");
+    assert(w[i]._key == b._key && w[i]._idx == b._idx, "par_sort_by_key: same as par_sort_by");
+  }
+
+  auto xs = Vec<i32>::with_capacity(N);
+  for (usize i = 0; i < N; ++i) {
+    xs.push(i32(N / 2) - i32(i));
+  }
+  thread::par_sort(xs);
+  assert(xs.as_slice().is_sorted(), "par_sort: radix");
+  assert_eq(xs[0], i32(N / 2) - i32(N - 1));
+}
+
+}  // namespace sfc::thread
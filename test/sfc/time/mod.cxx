@@ -0,0 +1,30 @@
+#include "sfc/test.h"
+#include "sfc/thread.h"
+#include "sfc/time.h"
+
+namespace sfc::time {
+
+sfc_test(instant) {
+  const auto t0 = Instant::now();
+  thread::sleep(Duration::from_millis(20));
+  const auto dt = t0.elpased();
+  assert(dt.total_nanos() >= 20 * NANOS_PER_MILLI, "instant: wall time, not cpu time");
+
+  const auto c = Instant::now_coarse();
+  assert(c.total_nanos() <= Instant::now().total_nanos(), "instant: coarse is never ahead");
+}
+
+sfc_test(fast_instant) {
+  assert(Tsc::ticks_per_sec() > 0, "tsc: calibrated");
+
+  const auto t0 = Instant::now();
+  const auto f0 = FastInstant::now();
+  thread::sleep(Duration::from_millis(50));
+  const auto dt = t0.elpased().as_secs_f64();
+  const auto df = f0.elapsed().as_secs_f64();
+  assert(df > dt * 0.8 && df < dt * 1.2, "tsc: {} vs {}", df, dt);
+
+  assert(Tsc::ticks_ordered() >= f0._ticks, "tsc: monotonic");
+}
+
+}  // namespace sfc::time
@@ -0,0 +1,92 @@
+#include "sfc/test.h"
+#include "sfc/thread.h"
+#include "sfc/trace.h"
+
+namespace sfc::trace {
+
+static auto count(Slice<const Event> events, Str name) -> usize {
+  auto res = usize(0);
+  for (usize i = 0; i < events.len(); ++i) {
+    res += events[i]._name == name ? 1 : 0;
+  }
+  return res;
+}
+
+// spans of this test only: others may trace while it runs.
+static auto count_ours(Slice<const Event> events) -> usize {
+  auto res = usize(0);
+  for (usize i = 0; i < events.len(); ++i) {
+    res += events[i]._name.starts_with("trace::test::") ? 1 : 0;
+  }
+  return res;
+}
+
+sfc_test(span) {
+  trace::enable();
+  (void)trace::collect();
+
+  {
+    const auto outer = Span{"trace::test::outer"};
+    for (auto i = 0u; i < 3; ++i) {
+      const auto inner = Span{"trace::test::inner"};
+      thread::sleep(time::Duration::from_micros(100));
+    }
+  }
+  thread::Pool::global().for_each(4, [](usize) { const auto span = Span{"trace::test::task"}; });
+
+  trace::disable();
+  { const auto off = Span{"trace::test::off"}; }
+
+  const auto events = trace::collect();
+  assert_eq(count(events.as_slice(), "trace::test::outer"), 1u);
+  assert_eq(count(events.as_slice(), "trace::test::inner"), 3u);
+  assert_eq(count(events.as_slice(), "trace::test::task"), 4u);
+  assert_eq(count(events.as_slice(), "trace::test::off"), 0u);
+  assert(count(events.as_slice(), "thread::Pool::for_each") >= 1, "span: pool shows up");
+
+  for (usize i = 0; i < events.len(); ++i) {
+    if (events[i]._name == Str{"trace::test::outer"}) {
+      assert(events[i]._dur >= 300000, "span: outer covers the inner sleeps");
+    }
+  }
+  const auto again = trace::collect();
+  assert_eq(count_ours(again.as_slice()), 0u);
+
+  const auto json = trace::to_json(events.as_slice());
+  assert(json.starts_with("{\"displayTimeUnit\""), "to_json: object");
+  assert((*json).find("\"ph\": \"X\"").is_some(), "to_json: complete events");
+
+  // tracing is global, so the threaded part shares this test.
+  trace::enable();
+  thread::scope([](thread::Scope& s) {
+    for (auto t = 0u; t < 4; ++t) {
+      s.spawn([] {
+        for (auto i = 0u; i < 1000; ++i) {
+          const auto span = Span{"trace::test::thread"};
+        }
+      });
+    }
+  });
+  trace::disable();
+  const auto threaded = trace::collect();
+  assert_eq(count(threaded.as_slice(), "trace::test::thread"), 4000u);
+
+  // the ring of a thread that exited keeps its spans, and its tid, until
+  // collected; the next thread gets another.
+  trace::enable();
+  thread::scope([](thread::Scope& s) { s.spawn([] { const auto span = Span{"trace::test::first"}; }); });
+  thread::scope([](thread::Scope& s) { s.spawn([] { const auto span = Span{"trace::test::second"}; }); });
+  trace::disable();
+  const auto exited = trace::collect();
+  assert_eq(count(exited.as_slice(), "trace::test::first"), 1u);
+  assert_eq(count(exited.as_slice(), "trace::test::second"), 1u);
+  auto tids = Vec<u32>{};
+  for (usize i = 0; i < exited.len(); ++i) {
+    if (exited[i]._name.starts_with("trace::test::")) {
+      tids.push(exited[i]._tid);
+    }
+  }
+  assert(tids[0] != tids[1], "collect: a reused ring keeps its tid");
+}
+
+}  // namespace sfc::trace